@@ -8,141 +8,164 @@
  
  // --- Variables statiques globales ---
  static I2C_HandleTypeDef *ads_hi2c = NULL; // Pointeur vers le gestionnaire du périphérique I2C
- static ADS1115_Module ads_modules[MAX_ADS1115_MODULES]; // Tableau des modules
+ static ADS1115_Handle ads_modules[MAX_ADS1115_MODULES]; // Tableau des modules (un handle par module)
  static uint8_t ads_moduleCount = 0;                    // Nombre de modules ajoutés
  static int8_t ads_selectedModule = -1;                 // Index du module actuellement sélectionné (-1 si aucun)
  
+ #if (ADS1115_RDY_BUFFER_SIZE & (ADS1115_RDY_BUFFER_SIZE - 1)) != 0
+ #error "ADS1115_RDY_BUFFER_SIZE doit être une puissance de 2"
+ #endif
+ 
+ // --- État du mode Conversion Ready (écrit par l'interruption EXTI) ---
+ static volatile int16_t ads_rdyBuffer[ADS1115_RDY_BUFFER_SIZE]; // Tampon circulaire des échantillons
+ static volatile uint16_t ads_rdyHead = 0;     // Index d'écriture (modifié uniquement par l'interruption)
+ static volatile uint16_t ads_rdyTail = 0;     // Index de lecture (modifié uniquement par le code principal)
+ static volatile uint32_t ads_rdyDropped = 0;  // Échantillons perdus (tampon plein ou erreur I2C)
+ static volatile bool ads_rdyActive = false;   // true si le mode Conversion Ready est actif
+ static ADS1115_Handle *ads_rdyHandle = NULL;  // Module en mode Conversion Ready
+ 
+ // --- État du balayage multi-modules ---
+ typedef enum {
+     ADS1115_SCAN_IDLE = 0,   // Aucune conversion en cours
+     ADS1115_SCAN_CONVERTING, // Conversion lancée, en attente du résultat
+     ADS1115_SCAN_DONE        // Tous les canaux de la trame sont traités pour ce module
+ } ADS1115_ScanState;
+ 
+ typedef struct {
+     ADS1115_ScanState state; // État du module dans la trame courante
+     uint8_t channel;         // Canal en cours de conversion
+     uint32_t startTick;      // HAL_GetTick() au lancement de la conversion
+     uint32_t readyMs;        // Temps de conversion attendu (ms) selon le data rate du module
+ } ADS1115_ScanSlot;
+ 
+ static ADS1115_ScanSlot ads_scanSlots[MAX_ADS1115_MODULES];
+ static ADS1115_ScanFrame ads_scanFrame;       // Trame en cours d'acquisition
+ static uint8_t ads_scanMask = 0;              // Canaux à balayer (bit 0 = AIN0)
+ static uint8_t ads_scanNext = 0;              // Premier module examiné au prochain appel (équité round-robin)
+ static bool ads_scanActive = false;           // true si le balayage est démarré
+ 
+ // Pas d'un LSB en µV x 16 pour chaque réglage PGA (index = bits PGA >> 9). Les codes 6 et 7 valent ±0.256V.
+ static const uint16_t ads_lsbMicroVoltsQ4[8] = {
+     3000, // ±6.144V : 187.5 µV
+     2000, // ±4.096V : 125 µV
+     1000, // ±2.048V : 62.5 µV
+     500,  // ±1.024V : 31.25 µV
+     250,  // ±0.512V : 15.625 µV
+     125,  // ±0.256V : 7.8125 µV
+     125,
+     125
+ };
+ 
  // --- Prototypes des fonctions statiques internes ---
- static int16_t readADC(uint16_t mux_config);
+ static int16_t readADC(ADS1115_Handle *h, uint16_t mux_config);
  static uint16_t ADS1115_getDataRateSPS(uint16_t dr_value);
- static bool isSelectedModuleValid(void);
+ static bool isHandleValid(const ADS1115_Handle *h);
+ static ADS1115_Handle *selectedHandle(void);
+ static void updateConfigCache(ADS1115_Handle *h);
+ static uint16_t buildConfig(const ADS1115_Handle *h, uint16_t mux, bool continuous);
+ static uint16_t channelToMux(uint8_t channel);
+ static HAL_StatusTypeDef setPointer(ADS1115_Handle *h, uint8_t reg);
+ static bool isRdyLocked(const ADS1115_Handle *h);
+ static void scanStartFrame(void);
+ static bool scanStartChannel(uint8_t moduleIndex, uint8_t channel);
+ static void scanAdvance(uint8_t moduleIndex);
  
  // --- Implémentations des fonctions ---
  
  /**
-  * @brief Vérifie si un module valide est actuellement sélectionné.
-  */
- static bool isSelectedModuleValid(void) {
-     return (ads_selectedModule >= 0 && ads_selectedModule < ads_moduleCount && ads_modules[ads_selectedModule].initialized);
- }
- 
- /**
-  * @brief Initialise le pilote ADS1115 globalement.
+  * @brief Vérifie qu'un handle est utilisable (non NULL, initialisé et relié à un bus I2C).
   */
- void ADS1115_init(I2C_HandleTypeDef *hi2c_dev) {
-     ads_hi2c = hi2c_dev;
-     ads_moduleCount = 0;
-     ads_selectedModule = -1;
-     // Initialiser le tableau des modules (memset à 0 initialise bool à false)
-     memset(ads_modules, 0, sizeof(ads_modules));
-     // La boucle for n'est plus nécessaire après memset à 0
-     // for (int i = 0; i < MAX_ADS1115_MODULES; ++i) {
-     //     ads_modules[i].initialized = false;
-     // }
+ static bool isHandleValid(const ADS1115_Handle *h) {
+     return (h != NULL && h->initialized && h->hi2c != NULL);
  }
  
  /**
-  * @brief Ajoute un module ADS1115 avec l'adresse spécifiée.
+  * @brief Retourne le handle du module actuellement sélectionné, ou NULL si aucun module valide n'est sélectionné.
   */
- int ADS1115_addModule(uint8_t address) {
-     if (ads_hi2c == NULL) {
-         return -1; // Driver non initialisé avec ADS1115_init
+ static ADS1115_Handle *selectedHandle(void) {
+     if (ads_selectedModule >= 0 && ads_selectedModule < ads_moduleCount && ads_modules[ads_selectedModule].initialized) {
+         return &ads_modules[ads_selectedModule];
      }
-     if (ads_moduleCount >= MAX_ADS1115_MODULES) {
-         return -1; // Trop de modules
-     }
- 
-     uint8_t index = ads_moduleCount;
-     ads_modules[index].address = (address << 1); // Adresse 7 bits décalée pour HAL
-     ads_modules[index].gain = GAIN_TWOTHIRDS;    // Gain par défaut
-     ads_modules[index].dataRate = ADS1115_REG_CONFIG_DR_128SPS; // Taux par défaut
-     ads_modules[index].initialized = true;
-     ads_moduleCount++;
- 
-     // Sélectionne automatiquement le premier module ajouté
-     if (ads_selectedModule == -1) {
-         ADS1115_selectModule(index);
-     }
-     return index;
+     return NULL;
  }
  
- /**
-  * @brief Sélectionne un module ADS1115 par son index.
-  */
- bool ADS1115_selectModule(uint8_t moduleIndex) {
-     if (moduleIndex >= ads_moduleCount || !ads_modules[moduleIndex].initialized) {
-         ads_selectedModule = -1; // Désélectionner si index invalide
-         return false; // Index invalide ou module non initialisé
-     }
-     ads_selectedModule = moduleIndex;
-     return true;
- }
+ // ===========================================================================
+ // --- API par handle ---
+ // ===========================================================================
  
  /**
-  * @brief Obtient l'adresse du module ADS1115 actuellement sélectionné.
+  * @brief Initialise un handle ADS1115 avec les valeurs par défaut.
   */
- uint8_t ADS1115_getSelectedModuleAddress(void) {
-     if (!isSelectedModuleValid()) {
-         return 0; // Retourne 0 si aucun module valide n'est sélectionné
+ bool ADS1115_Handle_init(ADS1115_Handle *h, I2C_HandleTypeDef *hi2c, uint8_t address) {
+     if (h == NULL || hi2c == NULL) {
+         return false;
      }
-     return ads_modules[ads_selectedModule].address;
+     memset(h, 0, sizeof(*h));
+     h->hi2c = hi2c;
+     h->address = (address << 1);                // Adresse 7 bits décalée pour HAL
+     h->gain = GAIN_TWOTHIRDS;                   // Gain par défaut
+     h->dataRate = ADS1115_REG_CONFIG_DR_128SPS; // Taux par défaut
+     h->pointer = ADS1115_REG_POINTER_UNKNOWN;   // État du module inconnu tant qu'on ne lui a pas écrit
+     h->lastConfigValid = false;
+     updateConfigCache(h);
+     h->initialized = true;
+     return true;
  }
  
- 
  /**
-  * @brief Vérifie si le module ADS1115 *actuellement sélectionné* est connecté et réactif.
+  * @brief Vérifie si le module est connecté et réactif.
   */
- bool ADS1115_begin(void) {
-     if (!isSelectedModuleValid()) {
-         return false; // Aucun module valide sélectionné
+ bool ADS1115_Handle_begin(ADS1115_Handle *h) {
+     if (!isHandleValid(h)) {
+         return false;
      }
  
      // Essayer de lire le registre de configuration pour vérifier la communication I2C.
      uint16_t config_value;
-     HAL_StatusTypeDef status = ADS1115_readRegister(ADS1115_REG_POINTER_CONFIG, &config_value);
+     HAL_StatusTypeDef status = ADS1115_Handle_readRegister(h, ADS1115_REG_POINTER_CONFIG, &config_value);
  
      return (status == HAL_OK); // Communication réussie si la lecture I2C a fonctionné
  }
  
  /**
-  * @brief Définit le gain pour le module *actuellement sélectionné*.
+  * @brief Définit le gain du module et recalcule le mot de configuration en cache.
   */
- void ADS1115_setGain(adsGain_t gain) {
-     if (isSelectedModuleValid()) {
-         ads_modules[ads_selectedModule].gain = gain;
+ void ADS1115_Handle_setGain(ADS1115_Handle *h, adsGain_t gain) {
+     if (isHandleValid(h)) {
+         h->gain = gain;
+         updateConfigCache(h);
      }
      // Note: Le gain n'est appliqué au registre que lors de la prochaine écriture de config.
  }
  
  /**
-  * @brief Récupère le réglage actuel du gain pour le module *actuellement sélectionné*.
+  * @brief Récupère le réglage actuel du gain du module.
   */
- adsGain_t ADS1115_getGain(void) {
-      if (isSelectedModuleValid()) {
-         return ads_modules[ads_selectedModule].gain;
+ adsGain_t ADS1115_Handle_getGain(const ADS1115_Handle *h) {
+     if (isHandleValid(h)) {
+         return h->gain;
      }
      return GAIN_TWOTHIRDS; // Valeur par défaut ou d'erreur
  }
  
  /**
-  * @brief Définit le taux d'échantillonnage pour le module *actuellement sélectionné*.
+  * @brief Définit le taux d'échantillonnage du module et recalcule le mot de configuration en cache.
   */
- void ADS1115_setDataRate(uint16_t rate) {
-     if (isSelectedModuleValid()) {
+ void ADS1115_Handle_setDataRate(ADS1115_Handle *h, uint16_t rate) {
+     if (isHandleValid(h)) {
          // Vérifier si le taux est valide (masquer les bits non pertinents)
-         uint16_t valid_rate = rate & ADS1115_REG_CONFIG_DR_MASK;
-         // On pourrait ajouter une vérification plus stricte ici si nécessaire
-         ads_modules[ads_selectedModule].dataRate = valid_rate;
+         h->dataRate = rate & ADS1115_REG_CONFIG_DR_MASK;
+         updateConfigCache(h);
      }
      // Note: Le taux n'est appliqué au registre que lors de la prochaine écriture de config.
  }
  
  /**
-  * @brief Récupère le réglage actuel du taux d'échantillonnage pour le module *actuellement sélectionné*.
+  * @brief Récupère le réglage actuel du taux d'échantillonnage du module.
   */
- uint16_t ADS1115_getDataRate(void) {
-     if (isSelectedModuleValid()) {
-         return ads_modules[ads_selectedModule].dataRate;
+ uint16_t ADS1115_Handle_getDataRate(const ADS1115_Handle *h) {
+     if (isHandleValid(h)) {
+         return h->dataRate;
      }
      return ADS1115_REG_CONFIG_DR_128SPS; // Valeur par défaut ou d'erreur
  }
@@ -150,63 +173,30 @@
  /**
   * @brief Obtient une lecture ADC en mode simple à partir du canal spécifié.
   */
- int16_t ADS1115_readADC_SingleEnded(uint8_t channel) {
-     if (channel > 3 || !isSelectedModuleValid()) {
-         return INT16_MIN; // Canal invalide ou module non sélectionné
-     }
- 
-     // Définir les réglages du multiplexeur pour les canaux en mode simple
-     uint16_t mux_config;
-     switch (channel) {
-         case 0: mux_config = ADS1115_REG_CONFIG_MUX_SINGLE_0; break;
-         case 1: mux_config = ADS1115_REG_CONFIG_MUX_SINGLE_1; break;
-         case 2: mux_config = ADS1115_REG_CONFIG_MUX_SINGLE_2; break;
-         case 3: mux_config = ADS1115_REG_CONFIG_MUX_SINGLE_3; break;
-         default: return INT16_MIN; // Ne devrait pas arriver
+ int16_t ADS1115_Handle_readADC_SingleEnded(ADS1115_Handle *h, uint8_t channel) {
+     if (channel > 3 || !isHandleValid(h)) {
+         return INT16_MIN; // Canal invalide ou handle invalide
      }
- 
-     return readADC(mux_config); // Appelle la fonction interne qui gère la lecture single-shot
- }
- 
- /**
-  * @brief Lit la différence de tension entre AIN0 et AIN1.
-  */
- int16_t ADS1115_readADC_Differential_0_1(void) {
-     if (!isSelectedModuleValid()) return INT16_MIN;
-     return readADC(ADS1115_REG_CONFIG_MUX_DIFF_0_1);
+     return readADC(h, channelToMux(channel)); // Appelle la fonction interne qui gère la lecture single-shot
  }
  
  /**
-  * @brief Lit la différence de tension entre AIN0 et AIN3.
-  */
- int16_t ADS1115_readADC_Differential_0_3(void) {
-      if (!isSelectedModuleValid()) return INT16_MIN;
-     return readADC(ADS1115_REG_CONFIG_MUX_DIFF_0_3);
- }
- 
- /**
-  * @brief Lit la différence de tension entre AIN1 et AIN3.
-  */
- int16_t ADS1115_readADC_Differential_1_3(void) {
-      if (!isSelectedModuleValid()) return INT16_MIN;
-     return readADC(ADS1115_REG_CONFIG_MUX_DIFF_1_3);
- }
- 
- /**
-  * @brief Lit la différence de tension entre AIN2 et AIN3.
+  * @brief Lit une paire différentielle.
   */
- int16_t ADS1115_readADC_Differential_2_3(void) {
-      if (!isSelectedModuleValid()) return INT16_MIN;
-     return readADC(ADS1115_REG_CONFIG_MUX_DIFF_2_3);
+ int16_t ADS1115_Handle_readADC_Differential(ADS1115_Handle *h, uint16_t mux) {
+     if (!isHandleValid(h) || mux > ADS1115_REG_CONFIG_MUX_DIFF_2_3) {
+         return INT16_MIN; // Handle invalide ou MUX non différentiel
+     }
+     return readADC(h, mux);
  }
  
  /**
   * @brief Démarre le mode comparateur avec configuration étendue.
   */
- bool ADS1115_startComparator_SingleEnded(uint8_t channel, int16_t lowThreshold, int16_t highThreshold,
-                                          uint16_t compMode, uint16_t compPol, uint16_t compLat, uint16_t compQue) {
-     if (channel > 3 || !isSelectedModuleValid()) {
-         return false; // Canal invalide ou module non sélectionné
+ bool ADS1115_Handle_startComparator_SingleEnded(ADS1115_Handle *h, uint8_t channel, int16_t lowThreshold, int16_t highThreshold,
+                                                 uint16_t compMode, uint16_t compPol, uint16_t compLat, uint16_t compQue) {
+     if (channel > 3 || !isHandleValid(h)) {
+         return false; // Canal invalide ou handle invalide
      }
  
      // Vérifier la validité des paramètres du comparateur (masquer les bits non pertinents)
@@ -215,35 +205,21 @@
      compLat  &= ADS1115_REG_CONFIG_CLAT_MASK;
      compQue  &= ADS1115_REG_CONFIG_CQUE_MASK;
  
-     // Récupérer les paramètres du module sélectionné
-     adsGain_t current_gain = ads_modules[ads_selectedModule].gain;
-     uint16_t current_dataRate = ads_modules[ads_selectedModule].dataRate;
- 
-     // Définir les réglages du multiplexeur
-     uint16_t mux_config;
-     switch (channel) {
-         case 0: mux_config = ADS1115_REG_CONFIG_MUX_SINGLE_0; break;
-         case 1: mux_config = ADS1115_REG_CONFIG_MUX_SINGLE_1; break;
-         case 2: mux_config = ADS1115_REG_CONFIG_MUX_SINGLE_2; break;
-         case 3: mux_config = ADS1115_REG_CONFIG_MUX_SINGLE_3; break;
-         default: return false; // Ne devrait pas arriver
-     }
- 
      // Construire la configuration du comparateur
      uint16_t config = compQue | compLat | compPol | compMode |
                        ADS1115_REG_CONFIG_MODE_CONTIN; // Le comparateur fonctionne en mode continu
  
-     config |= current_gain;     // Utiliser le gain du module
-     config |= current_dataRate; // Utiliser le data rate du module
-     config |= mux_config;       // Définir le canal
+     config |= h->gain;               // Utiliser le gain du module
+     config |= h->dataRate;           // Utiliser le data rate du module
+     config |= channelToMux(channel); // Définir le canal
  
      HAL_StatusTypeDef status;
  
      // Écrire les registres de seuil (vérifier chaque écriture)
-     status = ADS1115_writeRegister(ADS1115_REG_POINTER_LOWTHRESH, (uint16_t)lowThreshold);
+     status = ADS1115_Handle_writeRegister(h, ADS1115_REG_POINTER_LOWTHRESH, (uint16_t)lowThreshold);
      if (status != HAL_OK) return false;
  
-     status = ADS1115_writeRegister(ADS1115_REG_POINTER_HITHRESH, (uint16_t)highThreshold);
+     status = ADS1115_Handle_writeRegister(h, ADS1115_REG_POINTER_HITHRESH, (uint16_t)highThreshold);
      if (status != HAL_OK) return false;
  
      // Écrire le registre de configuration pour démarrer le mode comparateur
@@ -251,7 +227,7 @@
      // démarre les conversions automatiquement. Si on voulait forcer une première
      // conversion immédiate, on pourrait ajouter `| ADS1115_REG_CONFIG_OS_SINGLE`
      // mais ce n'est généralement pas nécessaire pour le comparateur.
-     status = ADS1115_writeRegister(ADS1115_REG_POINTER_CONFIG, config);
+     status = ADS1115_Handle_writeRegister(h, ADS1115_REG_POINTER_CONFIG, config);
      if (status != HAL_OK) return false;
  
      return true; // Succès
@@ -260,14 +236,14 @@
  /**
   * @brief Lit les derniers résultats de conversion.
   */
- bool ADS1115_getLastConversionResults(int16_t *value) {
-     if (!isSelectedModuleValid() || value == NULL) {
+ bool ADS1115_Handle_getLastConversionResults(ADS1115_Handle *h, int16_t *value) {
+     if (!isHandleValid(h) || value == NULL) {
          if(value) *value = INT16_MIN; // Indiquer une erreur dans la valeur
-         return false; // Module non sélectionné ou pointeur nul
+         return false; // Handle invalide ou pointeur nul
      }
  
      uint16_t res_uint;
-     HAL_StatusTypeDef status = ADS1115_readRegister(ADS1115_REG_POINTER_CONVERT, &res_uint);
+     HAL_StatusTypeDef status = ADS1115_Handle_readRegister(h, ADS1115_REG_POINTER_CONVERT, &res_uint);
  
      if (status == HAL_OK) {
          *value = (int16_t)res_uint;
@@ -279,24 +255,11 @@
  }
  
  /**
-  * @brief Lit la dernière valeur convertie lorsque l'ADC est en mode continu.
-  */
- int16_t ADS1115_readContinuous(void) {
-     int16_t result;
-     if (ADS1115_getLastConversionResults(&result)) {
-         return result;
-     } else {
-         // getLastConversionResults met déjà result à INT16_MIN en cas d'erreur
-         return INT16_MIN;
-     }
- }
- 
- /**
-  * @brief Calcule la tension en volts.
+  * @brief Calcule la tension en volts selon le gain du module.
   */
- float ADS1115_computeVolts(int16_t counts) {
-     if (!isSelectedModuleValid()) {
-         return 0.0f; // Pas de module sélectionné
+ float ADS1115_Handle_computeVolts(const ADS1115_Handle *h, int16_t counts) {
+     if (!isHandleValid(h)) {
+         return 0.0f; // Handle invalide
      }
      // Si counts est INT16_MIN, cela indique une erreur de lecture précédente.
      if (counts == INT16_MIN) {
@@ -304,9 +267,7 @@
      }
  
      float fsRange;
-     adsGain_t current_gain = ads_modules[ads_selectedModule].gain; // Lire le gain du module
- 
-     switch (current_gain) { // Utiliser le gain du module
+     switch (h->gain) { // Utiliser le gain du module
          case GAIN_TWOTHIRDS: fsRange = 6.144f; break;
          case GAIN_ONE:       fsRange = 4.096f; break;
          case GAIN_TWO:       fsRange = 2.048f; break;
@@ -323,48 +284,111 @@
  }
  
  /**
-  * @brief Calcule la tension en millivolts.
+  * @brief Calcule la tension en millivolts selon le gain du module.
   */
- float ADS1115_computeMilliVolts(int16_t counts) {
+ float ADS1115_Handle_computeMilliVolts(const ADS1115_Handle *h, int16_t counts) {
      // Calcule d'abord en volts, gère les erreurs potentielles via computeVolts
-     float volts = ADS1115_computeVolts(counts);
+     float volts = ADS1115_Handle_computeVolts(h, counts);
      // Si computeVolts retourne 0.0f à cause d'une erreur ou d'une lecture nulle, mV sera aussi 0.0f
      return volts * 1000.0f;
  }
  
  /**
-  * @brief Démarre une conversion ADC (mode unique ou continu).
+  * @brief Convertit des comptes bruts en microvolts selon le gain du module.
   */
- bool ADS1115_startADCReading(uint16_t mux, bool continuous) {
-      if (!isSelectedModuleValid()) {
-         return false; // Module non sélectionné
+ int32_t ADS1115_Handle_computeMicroVolts(const ADS1115_Handle *h, int16_t counts) {
+     if (!isHandleValid(h)) {
+         return 0; // Handle invalide
      }
+     return ADS1115_countsToMicroVolts(counts, h->gain);
+ }
  
-     // Récupérer les paramètres du module sélectionné
-     adsGain_t current_gain = ads_modules[ads_selectedModule].gain;
-     uint16_t current_dataRate = ads_modules[ads_selectedModule].dataRate;
+ /**
+  * @brief Active ou désactive l'auto-ranging du PGA.
+  */
+ void ADS1115_Handle_setAutoRange(ADS1115_Handle *h, bool enable, adsGain_t widestGain) {
+     if (!isHandleValid(h)) {
+         return;
+     }
+     h->autoRange = enable;
+     h->autoRangeWidest = (adsGain_t)(widestGain & ADS1115_REG_CONFIG_PGA_MASK);
+     h->autoRangeLowCount = 0;
  
-     // Commencer avec les bits de configuration par défaut pour le mode non-comparateur
-      uint16_t config = ADS1115_REG_CONFIG_CQUE_NONE |    // Désactiver la fonction de comparateur
-                       ADS1115_REG_CONFIG_CLAT_NONLAT |  // Non verrouillé
-                       ADS1115_REG_CONFIG_CPOL_ACTVLOW | // Alerte/Rdy actif bas (non pertinent si CQUE_NONE)
-                       ADS1115_REG_CONFIG_CMODE_TRAD;    // Mode traditionnel (non pertinent si CQUE_NONE)
+     // Le gain courant doit respecter la plage la plus large autorisée
+     if (enable && h->gain < h->autoRangeWidest) {
+         ADS1115_Handle_setGain(h, h->autoRangeWidest);
+     }
+ }
  
-     if (continuous) {
-         config |= ADS1115_REG_CONFIG_MODE_CONTIN; // Mode continu
+ /**
+  * @brief Ajuste le gain d'un cran selon la dernière lecture (hystérésis entre les seuils haut et bas).
+  */
+ bool ADS1115_Handle_autoRangeUpdate(ADS1115_Handle *h, int16_t counts) {
+     if (!isHandleValid(h) || !h->autoRange || counts == INT16_MIN) {
+         return false;
+     }
+ 
+     int32_t magnitude = (counts < 0) ? -(int32_t)counts : counts;
+     uint16_t pga = (uint16_t)h->gain;
+ 
+     if (magnitude >= ADS1115_AUTORANGE_HIGH) {
+         // Proche de la saturation : plage plus large immédiatement
+         h->autoRangeLowCount = 0;
+         if (pga > (uint16_t)h->autoRangeWidest) {
+             ADS1115_Handle_setGain(h, (adsGain_t)(pga - ADS1115_REG_CONFIG_PGA_4_096V));
+             return true;
+         }
+     } else if (magnitude < ADS1115_AUTORANGE_LOW) {
+         // Signal faible : plage plus étroite seulement s'il le reste quelques lectures
+         if (pga < GAIN_SIXTEEN && ++h->autoRangeLowCount >= ADS1115_AUTORANGE_HOLD) {
+             h->autoRangeLowCount = 0;
+             ADS1115_Handle_setGain(h, (adsGain_t)(pga + ADS1115_REG_CONFIG_PGA_4_096V));
+             return true;
+         }
      } else {
-         config |= ADS1115_REG_CONFIG_MODE_SINGLE; // Mode unique
+         h->autoRangeLowCount = 0; // Dans la zone d'hystérésis : ne rien changer
+     }
+     return false;
+ }
+ 
+ /**
+  * @brief Lecture single-shot convertie en microvolts, puis mise à jour de l'auto-ranging.
+  */
+ bool ADS1115_Handle_readMicroVolts(ADS1115_Handle *h, uint16_t mux, int32_t *microVolts) {
+     if (!isHandleValid(h) || microVolts == NULL) {
+         return false;
      }
  
-     config |= current_gain;     // Utiliser le gain du module
-     config |= current_dataRate; // Utiliser le data rate du module
-     config |= mux;              // Définir la sélection du canal
+     adsGain_t gain = h->gain; // Gain utilisé pour cette conversion
+     int16_t counts = readADC(h, mux & ADS1115_REG_CONFIG_MUX_MASK);
+     if (counts == INT16_MIN) {
+         return false; // Erreur I2C ou timeout
+     }
  
-     // Définir le bit OS pour démarrer la conversion (nécessaire pour les deux modes)
-     config |= ADS1115_REG_CONFIG_OS_SINGLE;
+     *microVolts = ADS1115_countsToMicroVolts(counts, gain);
+     ADS1115_Handle_autoRangeUpdate(h, counts); // Prépare le gain de la prochaine conversion
+     return true;
+ }
+ 
+ /**
+  * @brief Démarre une conversion ADC (mode unique ou continu).
+  */
+ bool ADS1115_Handle_startADCReading(ADS1115_Handle *h, uint16_t mux, bool continuous) {
+     if (!isHandleValid(h)) {
+         return false; // Handle invalide
+     }
+ 
+     // Le mot de configuration en cache ne demande que le MUX, le mode et le bit OS
+     uint16_t config = buildConfig(h, mux, continuous);
+ 
+     // En mode continu, un module déjà configuré à l'identique convertit déjà : rien à écrire
+     if (continuous && h->lastConfigValid &&
+         h->lastConfig == (config & (uint16_t)~ADS1115_REG_CONFIG_OS_MASK)) {
+         return true;
+     }
  
      // Écrire le registre de configuration dans l'ADC
-     HAL_StatusTypeDef status = ADS1115_writeRegister(ADS1115_REG_POINTER_CONFIG, config);
+     HAL_StatusTypeDef status = ADS1115_Handle_writeRegister(h, ADS1115_REG_POINTER_CONFIG, config);
  
      return (status == HAL_OK); // Retourne true si l'écriture a réussi
  }
@@ -372,13 +396,13 @@
  /**
   * @brief Vérifie si une conversion ADC est terminée.
   */
- int8_t ADS1115_conversionComplete(void) {
-     if (!isSelectedModuleValid()) {
-         return -1; // Module non sélectionné -> Erreur
+ int8_t ADS1115_Handle_conversionComplete(ADS1115_Handle *h) {
+     if (!isHandleValid(h)) {
+         return -1; // Handle invalide -> Erreur
      }
  
      uint16_t config_value;
-     HAL_StatusTypeDef status = ADS1115_readRegister(ADS1115_REG_POINTER_CONFIG, &config_value);
+     HAL_StatusTypeDef status = ADS1115_Handle_readRegister(h, ADS1115_REG_POINTER_CONFIG, &config_value);
  
      if (status != HAL_OK) {
          return -1; // Erreur I2C
@@ -393,118 +417,978 @@
      }
  }
  
+ /**
+  * @brief Démarre le mode Conversion Ready (ALERT/RDY) en conversion continue.
+  */
+ bool ADS1115_Handle_startConversionReady(ADS1115_Handle *h, uint16_t mux, uint16_t compPol) {
+     if (!isHandleValid(h) || ads_scanActive) {
+         return false; // Handle invalide ou balayage en cours
+     }
+ 
+     ads_rdyActive = false; // Ignorer les impulsions pendant la reconfiguration
+ 
+     HAL_StatusTypeDef status;
+ 
+     // Motif RDY : MSB de Hi_thresh à 1 et MSB de Lo_thresh à 0
+     status = ADS1115_Handle_writeRegister(h, ADS1115_REG_POINTER_LOWTHRESH, ADS1115_LOWTHRESH_RDY);
+     if (status != HAL_OK) return false;
+ 
+     status = ADS1115_Handle_writeRegister(h, ADS1115_REG_POINTER_HITHRESH, ADS1115_HITHRESH_RDY);
+     if (status != HAL_OK) return false;
+ 
+     // Conversion continue, une impulsion ALERT/RDY par conversion (CQUE != NONE, non verrouillé)
+     uint16_t config = ADS1115_REG_CONFIG_CQUE_1CONV |
+                       ADS1115_REG_CONFIG_CLAT_NONLAT |
+                       (compPol & ADS1115_REG_CONFIG_CPOL_MASK) |
+                       ADS1115_REG_CONFIG_CMODE_TRAD |
+                       ADS1115_REG_CONFIG_MODE_CONTIN;
+     config |= h->gain;
+     config |= h->dataRate;
+     config |= (mux & ADS1115_REG_CONFIG_MUX_MASK);
+     config |= ADS1115_REG_CONFIG_OS_SINGLE;
+ 
+     // Vider le tampon avant la première impulsion
+     ads_rdyHead = 0;
+     ads_rdyTail = 0;
+     ads_rdyDropped = 0;
+     ads_rdyHandle = h;
+ 
+     status = ADS1115_Handle_writeRegister(h, ADS1115_REG_POINTER_CONFIG, config);
+     if (status != HAL_OK) return false;
+ 
+     // Placer le registre pointeur sur le registre de conversion une fois pour toutes :
+     // l'interruption n'aura plus qu'à lire 2 octets.
+     status = setPointer(h, ADS1115_REG_POINTER_CONVERT);
+     if (status != HAL_OK) return false;
+ 
+     ads_rdyActive = true;
+     return true;
+ }
+ 
  /**
   * @brief Écrit 16 bits dans le registre de destination spécifié.
   */
- HAL_StatusTypeDef ADS1115_writeRegister(uint8_t reg, uint16_t value) {
-     if (!isSelectedModuleValid()) {
+ HAL_StatusTypeDef ADS1115_Handle_writeRegister(ADS1115_Handle *h, uint8_t reg, uint16_t value) {
+     if (!isHandleValid(h)) {
          return HAL_ERROR; // Ou un autre code d'erreur approprié
      }
+     if (isRdyLocked(h)) {
+         return HAL_BUSY; // Le pointeur doit rester sur CONVERT pendant le mode Conversion Ready
+     }
  
      uint8_t data[3];
      data[0] = reg;                     // Octet du registre pointeur
      data[1] = (uint8_t)(value >> 8);   // MSB
      data[2] = (uint8_t)(value & 0xFF); // LSB
  
-     return HAL_I2C_Master_Transmit(ads_hi2c, ADS1115_getSelectedModuleAddress(), data, 3, ADS1115_I2C_TIMEOUT_MS);
+     h->txCount++;
+     HAL_StatusTypeDef status = HAL_I2C_Master_Transmit(h->hi2c, h->address, data, 3, ADS1115_I2C_TIMEOUT_MS);
+ 
+     // Une écriture de registre laisse le pointeur sur ce registre
+     if (status == HAL_OK) {
+         h->pointer = reg;
+         if (reg == ADS1115_REG_POINTER_CONFIG) {
+             h->lastConfig = value & (uint16_t)~ADS1115_REG_CONFIG_OS_MASK;
+             h->lastConfigValid = true;
+         }
+     } else {
+         ADS1115_Handle_invalidateCache(h); // État du module incertain après une erreur
+     }
+     return status;
  }
  
  /**
   * @brief Lit 16 bits depuis le registre de destination spécifié.
   */
- HAL_StatusTypeDef ADS1115_readRegister(uint8_t reg, uint16_t *value) {
-     if (!isSelectedModuleValid() || value == NULL) {
+ HAL_StatusTypeDef ADS1115_Handle_readRegister(ADS1115_Handle *h, uint8_t reg, uint16_t *value) {
+     if (!isHandleValid(h) || value == NULL) {
           if(value) *value = 0; // Mettre une valeur par défaut en cas d'erreur
-         return HAL_ERROR; // Module non sélectionné ou pointeur nul
+         return HAL_ERROR; // Handle invalide ou pointeur nul
+     }
+     if (isRdyLocked(h)) {
+         *value = 0;
+         return HAL_BUSY; // Le pointeur doit rester sur CONVERT pendant le mode Conversion Ready
      }
  
-     uint8_t reg_ptr = reg;
      uint8_t data[2] = {0, 0};
      HAL_StatusTypeDef status;
  
-     // Étape 1: Envoyer l'adresse du registre à lire
-     status = HAL_I2C_Master_Transmit(ads_hi2c, ADS1115_getSelectedModuleAddress(), &reg_ptr, 1, ADS1115_I2C_TIMEOUT_MS);
+     // Étape 1: Envoyer l'adresse du registre à lire (seulement si le pointeur n'y est pas déjà)
+     status = setPointer(h, reg);
      if (status != HAL_OK) {
          *value = 0; // Mettre une valeur par défaut en cas d'erreur
          return status; // Retourner l'erreur de transmission
      }
  
      // Étape 2: Lire les 2 octets du registre
-     status = HAL_I2C_Master_Receive(ads_hi2c, ADS1115_getSelectedModuleAddress(), data, 2, ADS1115_I2C_TIMEOUT_MS);
+     h->txCount++;
+     status = HAL_I2C_Master_Receive(h->hi2c, h->address, data, 2, ADS1115_I2C_TIMEOUT_MS);
      if (status == HAL_OK) {
          *value = ((uint16_t)data[0] << 8) | data[1]; // Combiner les octets si la réception réussit
      } else {
          *value = 0; // Mettre une valeur par défaut en cas d'erreur
+         ADS1115_Handle_invalidateCache(h);
      }
  
      return status; // Retourner le statut de la réception
  }
  
- // --- Fonctions utilitaires internes ---
+ /**
+  * @brief Nombre de transactions I2C émises vers le module.
+  */
+ uint32_t ADS1115_Handle_getTransactionCount(const ADS1115_Handle *h) {
+     return (h != NULL) ? h->txCount + h->isrTxCount : 0;
+ }
  
  /**
-  * @brief Fonction interne pour démarrer, attendre et lire la valeur ADC pour un réglage de multiplexeur donné.
-  *        Utilise IMPERATIVEMENT le mode unique (single-shot). Gère les erreurs I2C et timeout.
-  *        Utilisée par les fonctions readADC_SingleEnded et readADC_Differential_*.
+  * @brief Remet à zéro le compteur de transactions I2C du module.
   */
- static int16_t readADC(uint16_t mux_config) {
-     // Démarrer une conversion unique pour le canal donné
-     if (!ADS1115_startADCReading(mux_config, false)) { // false = mode unique
-         return INT16_MIN; // Erreur I2C lors du démarrage
+ void ADS1115_Handle_resetTransactionCount(ADS1115_Handle *h) {
+     if (h != NULL) {
+         h->txCount = 0;
+         h->isrTxCount = 0;
      }
+ }
  
-     // Récupérer le data rate actuel pour calculer le timeout
-     uint16_t current_dataRate = ads_modules[ads_selectedModule].dataRate;
-     uint16_t sps = ADS1115_getDataRateSPS(current_dataRate);
-     // Calculer le délai de conversion en ms, ajouter une marge (+2ms) et s'assurer qu'il n'est pas trop court
-     uint32_t conversion_delay_ms = 2 + (1000 / sps);
-     if (conversion_delay_ms < ADS1115_MIN_CONVERSIONDELAY) {
-         conversion_delay_ms = ADS1115_MIN_CONVERSIONDELAY;
+ /**
+  * @brief Oublie le registre pointeur et la dernière configuration supposés du module.
+  */
+ void ADS1115_Handle_invalidateCache(ADS1115_Handle *h) {
+     if (h != NULL) {
+         h->pointer = ADS1115_REG_POINTER_UNKNOWN;
+         h->lastConfigValid = false;
      }
-     // Définir un timeout légèrement plus long que le temps de conversion attendu (ex: 2x ou +10ms)
-     uint32_t timeout_ms = conversion_delay_ms + 10; // Ajout d'une marge fixe
+ }
  
+ // ===========================================================================
+ // --- API globale (module sélectionné) ---
+ // ===========================================================================
  
-     // Attendre que la conversion soit terminée en interrogeant le bit OS
-     uint32_t start_time = HAL_GetTick();
-     int8_t conversion_status;
-     while (true) {
-         conversion_status = ADS1115_conversionComplete();
+ /**
+  * @brief Initialise le pilote ADS1115 globalement.
+  */
+ void ADS1115_init(I2C_HandleTypeDef *hi2c_dev) {
+     ads_hi2c = hi2c_dev;
+     ads_moduleCount = 0;
+     ads_selectedModule = -1;
+     // Initialiser le tableau des modules (memset à 0 initialise bool à false)
+     memset(ads_modules, 0, sizeof(ads_modules));
+ }
  
-         if (conversion_status == 1) { // Conversion terminée
-             break;
-         }
-         if (conversion_status == -1) { // Erreur I2C pendant la vérification
-              return INT16_MIN;
-         }
-         // Vérifier le timeout
-         uint32_t current_time = HAL_GetTick();
-         // Gérer le débordement du compteur HAL_GetTick()
-         uint32_t elapsed_time = (current_time >= start_time) ? (current_time - start_time) : (UINT32_MAX - start_time + current_time + 1);
+ /**
+  * @brief Ajoute un module ADS1115 avec l'adresse spécifiée.
+  */
+ int ADS1115_addModule(uint8_t address) {
+     if (ads_hi2c == NULL) {
+         return -1; // Driver non initialisé avec ADS1115_init
+     }
+     if (ads_moduleCount >= MAX_ADS1115_MODULES) {
+         return -1; // Trop de modules
+     }
  
-         if (elapsed_time > timeout_ms) {
-             // Gérer l'erreur de timeout
-             // printf("Timeout attente conversion!\r\n"); // Debug
-             return INT16_MIN; // Indiquer une erreur de timeout
-         }
-         // Petit délai optionnel pour ne pas surcharger le CPU/Bus, surtout si le timeout est long
-         // HAL_Delay(1); // Peut être nécessaire pour les data rates très lents, mais augmente la latence
+     uint8_t index = ads_moduleCount;
+     ADS1115_Handle_init(&ads_modules[index], ads_hi2c, address);
+     ads_moduleCount++;
+ 
+     // Sélectionne automatiquement le premier module ajouté
+     if (ads_selectedModule == -1) {
+         ADS1115_selectModule(index);
      }
+     return index;
+ }
  
-     // Lire les résultats de la conversion
-     int16_t result;
-     if (ADS1115_getLastConversionResults(&result)) {
-         return result;
-     } else {
-         return INT16_MIN; // Erreur I2C lors de la lecture du résultat
+ /**
+  * @brief Sélectionne un module ADS1115 par son index.
+  */
+ bool ADS1115_selectModule(uint8_t moduleIndex) {
+     if (moduleIndex >= ads_moduleCount || !ads_modules[moduleIndex].initialized) {
+         ads_selectedModule = -1; // Désélectionner si index invalide
+         return false; // Index invalide ou module non initialisé
      }
+     ads_selectedModule = moduleIndex;
+     return true;
  }
  
  /**
-  * @brief Convertit la valeur du registre Data Rate en Samples Per Second (SPS).
+  * @brief Retourne le handle d'un module ajouté.
   */
- static uint16_t ADS1115_getDataRateSPS(uint16_t dr_value) {
-     // Masquer les bits non pertinents pour être sûr
+ ADS1115_Handle *ADS1115_getModuleHandle(uint8_t moduleIndex) {
+     if (moduleIndex >= ads_moduleCount || !ads_modules[moduleIndex].initialized) {
+         return NULL;
+     }
+     return &ads_modules[moduleIndex];
+ }
+ 
+ /**
+  * @brief Obtient l'adresse du module ADS1115 actuellement sélectionné.
+  */
+ uint8_t ADS1115_getSelectedModuleAddress(void) {
+     ADS1115_Handle *h = selectedHandle();
+     if (h == NULL) {
+         return 0; // Retourne 0 si aucun module valide n'est sélectionné
+     }
+     return h->address;
+ }
+ 
+ /**
+  * @brief Vérifie si le module ADS1115 *actuellement sélectionné* est connecté et réactif.
+  */
+ bool ADS1115_begin(void) {
+     return ADS1115_Handle_begin(selectedHandle());
+ }
+ 
+ /**
+  * @brief Définit le gain pour le module *actuellement sélectionné*.
+  */
+ void ADS1115_setGain(adsGain_t gain) {
+     ADS1115_Handle_setGain(selectedHandle(), gain);
+ }
+ 
+ /**
+  * @brief Récupère le réglage actuel du gain pour le module *actuellement sélectionné*.
+  */
+ adsGain_t ADS1115_getGain(void) {
+     return ADS1115_Handle_getGain(selectedHandle());
+ }
+ 
+ /**
+  * @brief Définit le taux d'échantillonnage pour le module *actuellement sélectionné*.
+  */
+ void ADS1115_setDataRate(uint16_t rate) {
+     ADS1115_Handle_setDataRate(selectedHandle(), rate);
+ }
+ 
+ /**
+  * @brief Récupère le réglage actuel du taux d'échantillonnage pour le module *actuellement sélectionné*.
+  */
+ uint16_t ADS1115_getDataRate(void) {
+     return ADS1115_Handle_getDataRate(selectedHandle());
+ }
+ 
+ /**
+  * @brief Obtient une lecture ADC en mode simple à partir du canal spécifié.
+  */
+ int16_t ADS1115_readADC_SingleEnded(uint8_t channel) {
+     return ADS1115_Handle_readADC_SingleEnded(selectedHandle(), channel);
+ }
+ 
+ /**
+  * @brief Lit la différence de tension entre AIN0 et AIN1.
+  */
+ int16_t ADS1115_readADC_Differential_0_1(void) {
+     return ADS1115_Handle_readADC_Differential(selectedHandle(), ADS1115_REG_CONFIG_MUX_DIFF_0_1);
+ }
+ 
+ /**
+  * @brief Lit la différence de tension entre AIN0 et AIN3.
+  */
+ int16_t ADS1115_readADC_Differential_0_3(void) {
+     return ADS1115_Handle_readADC_Differential(selectedHandle(), ADS1115_REG_CONFIG_MUX_DIFF_0_3);
+ }
+ 
+ /**
+  * @brief Lit la différence de tension entre AIN1 et AIN3.
+  */
+ int16_t ADS1115_readADC_Differential_1_3(void) {
+     return ADS1115_Handle_readADC_Differential(selectedHandle(), ADS1115_REG_CONFIG_MUX_DIFF_1_3);
+ }
+ 
+ /**
+  * @brief Lit la différence de tension entre AIN2 et AIN3.
+  */
+ int16_t ADS1115_readADC_Differential_2_3(void) {
+     return ADS1115_Handle_readADC_Differential(selectedHandle(), ADS1115_REG_CONFIG_MUX_DIFF_2_3);
+ }
+ 
+ /**
+  * @brief Démarre le mode comparateur avec configuration étendue.
+  */
+ bool ADS1115_startComparator_SingleEnded(uint8_t channel, int16_t lowThreshold, int16_t highThreshold,
+                                          uint16_t compMode, uint16_t compPol, uint16_t compLat, uint16_t compQue) {
+     return ADS1115_Handle_startComparator_SingleEnded(selectedHandle(), channel, lowThreshold, highThreshold,
+                                                       compMode, compPol, compLat, compQue);
+ }
+ 
+ /**
+  * @brief Lit les derniers résultats de conversion.
+  */
+ bool ADS1115_getLastConversionResults(int16_t *value) {
+     return ADS1115_Handle_getLastConversionResults(selectedHandle(), value);
+ }
+ 
+ /**
+  * @brief Lit la dernière valeur convertie lorsque l'ADC est en mode continu.
+  */
+ int16_t ADS1115_readContinuous(void) {
+     int16_t result;
+     if (ADS1115_getLastConversionResults(&result)) {
+         return result;
+     } else {
+         // getLastConversionResults met déjà result à INT16_MIN en cas d'erreur
+         return INT16_MIN;
+     }
+ }
+ 
+ /**
+  * @brief Calcule la tension en volts.
+  */
+ float ADS1115_computeVolts(int16_t counts) {
+     return ADS1115_Handle_computeVolts(selectedHandle(), counts);
+ }
+ 
+ /**
+  * @brief Calcule la tension en millivolts.
+  */
+ float ADS1115_computeMilliVolts(int16_t counts) {
+     return ADS1115_Handle_computeMilliVolts(selectedHandle(), counts);
+ }
+ 
+ /**
+  * @brief Convertit des comptes bruts en microvolts pour un gain donné (table de pas, sans flottant).
+  */
+ int32_t ADS1115_countsToMicroVolts(int16_t counts, adsGain_t gain) {
+     if (counts == INT16_MIN) {
+         return 0; // Erreur de lecture précédente
+     }
+     // |comptes| * pas <= 32768 * 3000 : tient sur 32 bits signés
+     int32_t scaled = (int32_t)counts * ads_lsbMicroVoltsQ4[((uint16_t)gain & ADS1115_REG_CONFIG_PGA_MASK) >> 9];
+     return (scaled + 8) >> 4; // Arrondi au µV le plus proche
+ }
+ 
+ /**
+  * @brief Calcule la tension en microvolts selon le gain du module sélectionné.
+  */
+ int32_t ADS1115_computeMicroVolts(int16_t counts) {
+     return ADS1115_Handle_computeMicroVolts(selectedHandle(), counts);
+ }
+ 
+ /**
+  * @brief Démarre une conversion ADC (mode unique ou continu).
+  */
+ bool ADS1115_startADCReading(uint16_t mux, bool continuous) {
+     return ADS1115_Handle_startADCReading(selectedHandle(), mux, continuous);
+ }
+ 
+ /**
+  * @brief Nombre de transactions I2C émises vers le module sélectionné.
+  */
+ uint32_t ADS1115_getTransactionCount(void) {
+     return ADS1115_Handle_getTransactionCount(selectedHandle());
+ }
+ 
+ /**
+  * @brief Remet à zéro le compteur de transactions I2C du module sélectionné.
+  */
+ void ADS1115_resetTransactionCount(void) {
+     ADS1115_Handle_resetTransactionCount(selectedHandle());
+ }
+ 
+ /**
+  * @brief Vérifie si une conversion ADC est terminée.
+  */
+ int8_t ADS1115_conversionComplete(void) {
+     return ADS1115_Handle_conversionComplete(selectedHandle());
+ }
+ 
+ /**
+  * @brief Démarre le mode Conversion Ready (ALERT/RDY) sur le module sélectionné.
+  */
+ bool ADS1115_startConversionReady(uint16_t mux, uint16_t compPol) {
+     return ADS1115_Handle_startConversionReady(selectedHandle(), mux, compPol);
+ }
+ 
+ /**
+  * @brief Écrit 16 bits dans le registre de destination spécifié.
+  */
+ HAL_StatusTypeDef ADS1115_writeRegister(uint8_t reg, uint16_t value) {
+     return ADS1115_Handle_writeRegister(selectedHandle(), reg, value);
+ }
+ 
+ /**
+  * @brief Lit 16 bits depuis le registre de destination spécifié.
+  */
+ HAL_StatusTypeDef ADS1115_readRegister(uint8_t reg, uint16_t *value) {
+     return ADS1115_Handle_readRegister(selectedHandle(), reg, value);
+ }
+ 
+ // ===========================================================================
+ // --- Mode Conversion Ready ---
+ // ===========================================================================
+ 
+ /**
+  * @brief Arrête le mode Conversion Ready.
+  */
+ bool ADS1115_stopConversionReady(void) {
+     if (!ads_rdyActive) {
+         return false; // Mode non actif
+     }
+     ads_rdyActive = false; // L'interruption ne lit plus rien à partir d'ici
+ 
+     ADS1115_Handle *h = ads_rdyHandle;
+     HAL_StatusTypeDef status;
+ 
+     // Repasser en single-shot (veille) et désactiver ALERT/RDY
+     status = ADS1115_Handle_writeRegister(h, ADS1115_REG_POINTER_CONFIG,
+                                           ADS1115_REG_CONFIG_CQUE_NONE | ADS1115_REG_CONFIG_MODE_SINGLE);
+     if (status != HAL_OK) return false;
+ 
+     // Restaurer les seuils par défaut
+     status = ADS1115_Handle_writeRegister(h, ADS1115_REG_POINTER_LOWTHRESH, ADS1115_LOWTHRESH_DEFAULT);
+     if (status != HAL_OK) return false;
+ 
+     status = ADS1115_Handle_writeRegister(h, ADS1115_REG_POINTER_HITHRESH, ADS1115_HITHRESH_DEFAULT);
+ 
+     return (status == HAL_OK);
+ }
+ 
+ /**
+  * @brief Lit le registre de conversion depuis l'interruption ALERT/RDY et remplit le tampon circulaire.
+  */
+ void ADS1115_conversionReadyCallback(void) {
+     if (!ads_rdyActive) {
+         return; // Impulsion parasite ou mode arrêté
+     }
+ 
+     uint16_t head = ads_rdyHead;
+     if ((uint16_t)(head - ads_rdyTail) >= ADS1115_RDY_BUFFER_SIZE) {
+         ads_rdyDropped++; // Tampon plein : le consommateur est en retard
+         return;
+     }
+ 
+     // Lecture directe de 2 octets, valable uniquement si le pointeur est resté sur le registre de conversion.
+     // Sinon (cache invalidé, erreur), on lirait un autre registre : l'échantillon est perdu plutôt que faux.
+     if (ads_rdyHandle->pointer != ADS1115_REG_POINTER_CONVERT) {
+         ads_rdyDropped++;
+         return;
+     }
+     uint8_t data[2];
+     ads_rdyHandle->isrTxCount++; // Compteur propre à l'interruption : pas de course avec txCount
+     if (HAL_I2C_Master_Receive(ads_rdyHandle->hi2c, ads_rdyHandle->address, data, 2, ADS1115_I2C_TIMEOUT_MS) != HAL_OK) {
+         ads_rdyDropped++; // Bus occupé ou erreur I2C
+         return;
+     }
+ 
+     ads_rdyBuffer[head & (ADS1115_RDY_BUFFER_SIZE - 1)] = (int16_t)(((uint16_t)data[0] << 8) | data[1]);
+     ads_rdyHead = head + 1; // Publier l'échantillon après l'écriture dans le tampon
+ }
+ 
+ /**
+  * @brief Nombre d'échantillons disponibles dans le tampon circulaire.
+  */
+ uint16_t ADS1115_available(void) {
+     return (uint16_t)(ads_rdyHead - ads_rdyTail);
+ }
+ 
+ /**
+  * @brief Retire l'échantillon le plus ancien du tampon circulaire.
+  */
+ bool ADS1115_readBuffered(int16_t *value) {
+     if (value == NULL) {
+         return false;
+     }
+     uint16_t tail = ads_rdyTail;
+     if (tail == ads_rdyHead) {
+         return false; // Tampon vide
+     }
+     *value = ads_rdyBuffer[tail & (ADS1115_RDY_BUFFER_SIZE - 1)];
+     ads_rdyTail = tail + 1; // Libérer la case après la copie
+     return true;
+ }
+ 
+ /**
+  * @brief Nombre d'échantillons perdus depuis le dernier démarrage du mode Conversion Ready.
+  */
+ uint32_t ADS1115_getDroppedSamples(void) {
+     return ads_rdyDropped;
+ }
+ 
+ // ===========================================================================
+ // --- Balayage multi-modules ---
+ // ===========================================================================
+ 
+ /**
+  * @brief Démarre le balayage round-robin des canaux single-ended sur tous les modules.
+  */
+ bool ADS1115_scanStart(uint8_t channelMask) {
+     channelMask &= 0x0F; // Seuls AIN0 à AIN3 sont valides
+     if (ads_hi2c == NULL || ads_moduleCount == 0 || channelMask == 0 || ads_rdyActive) {
+         return false;
+     }
+ 
+     ads_scanMask = channelMask;
+     ads_scanNext = 0;
+     ads_scanActive = true;
+     scanStartFrame();
+ 
+     // Vérifier qu'au moins un module a effectivement démarré
+     for (uint8_t i = 0; i < ads_moduleCount; i++) {
+         if (ads_scanSlots[i].state == ADS1115_SCAN_CONVERTING) {
+             return true;
+         }
+     }
+     ads_scanActive = false;
+     return false;
+ }
+ 
+ /**
+  * @brief Fait avancer le balayage sans bloquer.
+  */
+ bool ADS1115_scanPoll(ADS1115_ScanFrame *frame) {
+     if (!ads_scanActive) {
+         return false;
+     }
+ 
+     // Servir les modules dont la conversion devrait être terminée, en commençant
+     // après le dernier module servi pour ne favoriser aucun module.
+     // Le point de départ est figé pendant le parcours : chaque module est examiné une fois.
+     uint8_t start = ads_scanNext;
+     int16_t lastServed = -1;
+     for (uint8_t n = 0; n < ads_moduleCount; n++) {
+         uint8_t i = (uint8_t)((start + n) % ads_moduleCount);
+         ADS1115_ScanSlot *slot = &ads_scanSlots[i];
+         if (slot->state != ADS1115_SCAN_CONVERTING) {
+             continue;
+         }
+ 
+         // Ne pas toucher au bus avant la fin théorique de la conversion
+         uint32_t elapsed = HAL_GetTick() - slot->startTick;
+         if (elapsed < slot->readyMs) {
+             continue;
+         }
+ 
+         uint16_t config_value;
+         HAL_StatusTypeDef status = ADS1115_Handle_readRegister(&ads_modules[i], ADS1115_REG_POINTER_CONFIG, &config_value);
+         if (status == HAL_OK && (config_value & ADS1115_REG_CONFIG_OS_MASK) == 0) {
+             // Conversion encore en cours (oscillateur interne plus lent que prévu)
+             if (elapsed <= slot->readyMs + ADS1115_SCAN_TIMEOUT_MS) {
+                 continue;
+             }
+             status = HAL_TIMEOUT;
+         }
+ 
+         if (status == HAL_OK) {
+             uint16_t res_uint;
+             status = ADS1115_Handle_readRegister(&ads_modules[i], ADS1115_REG_POINTER_CONVERT, &res_uint);
+             if (status == HAL_OK) {
+                 ads_scanFrame.values[i][slot->channel] = (int16_t)res_uint;
+                 ads_scanFrame.validMask |= (uint16_t)(1u << (i * ADS1115_SCAN_CHANNELS + slot->channel));
+             }
+         }
+         // En cas d'erreur la valeur reste à INT16_MIN et le canal suivant est lancé
+         scanAdvance(i);
+         lastServed = i;
+     }
+     if (lastServed >= 0) {
+         ads_scanNext = (uint8_t)((lastServed + 1) % ads_moduleCount);
+     }
+ 
+     // La trame est complète quand plus aucun module n'est en conversion
+     for (uint8_t i = 0; i < ads_moduleCount; i++) {
+         if (ads_scanSlots[i].state == ADS1115_SCAN_CONVERTING) {
+             return false;
+         }
+     }
+ 
+     if (frame != NULL) {
+         *frame = ads_scanFrame;
+     }
+     scanStartFrame(); // Enchaîner immédiatement la trame suivante
+     return true;
+ }
+ 
+ /**
+  * @brief Attend la prochaine trame complète du balayage.
+  */
+ bool ADS1115_scanReadFrame(ADS1115_ScanFrame *frame, uint32_t timeout_ms) {
+     uint32_t start_time = HAL_GetTick();
+     while (ads_scanActive) {
+         if (ADS1115_scanPoll(frame)) {
+             return true;
+         }
+         if ((HAL_GetTick() - start_time) > timeout_ms) {
+             return false; // Timeout
+         }
+     }
+     return false; // Balayage non démarré
+ }
+ 
+ /**
+  * @brief Arrête le balayage.
+  */
+ void ADS1115_scanStop(void) {
+     ads_scanActive = false;
+     for (uint8_t i = 0; i < MAX_ADS1115_MODULES; i++) {
+         ads_scanSlots[i].state = ADS1115_SCAN_IDLE;
+     }
+ }
+ 
+ // ===========================================================================
+ // --- Décimation ---
+ // ===========================================================================
+ 
+ /**
+  * @brief Initialise un étage de décimation.
+  */
+ bool ADS1115_Decimator_init(ADS1115_Decimator *d, ADS1115_DecimMode mode, uint16_t ratio) {
+     if (d == NULL || ratio == 0) {
+         return false;
+     }
+ 
+     // log2(ratio) si puissance de 2 : la mise à l'échelle devient un simple décalage
+     uint8_t shift = 0xFF;
+     if ((ratio & (ratio - 1)) == 0) {
+         shift = 0;
+         while ((1u << shift) < ratio) {
+             shift++;
+         }
+     }
+ 
+     if (mode == ADS1115_DECIM_CIC2 && (shift == 0xFF || ratio > ADS1115_DECIM_CIC2_RATIO_MAX)) {
+         return false; // Le gain R^2 du CIC doit être une puissance de 2 et tenir sur 32 bits
+     }
+     if (mode == ADS1115_DECIM_MEDIAN && ratio > ADS1115_DECIM_MEDIAN_MAX) {
+         return false;
+     }
+     if (mode != ADS1115_DECIM_BOXCAR && mode != ADS1115_DECIM_CIC2 && mode != ADS1115_DECIM_MEDIAN) {
+         return false;
+     }
+ 
+     d->mode = mode;
+     d->ratio = ratio;
+     d->shift = shift;
+     ADS1115_Decimator_reset(d);
+     return true;
+ }
+ 
+ /**
+  * @brief Remet à zéro l'état du filtre.
+  */
+ void ADS1115_Decimator_reset(ADS1115_Decimator *d) {
+     if (d == NULL) {
+         return;
+     }
+     d->count = 0;
+     d->acc = 0;
+     d->integ1 = 0;
+     d->integ2 = 0;
+     d->comb1 = 0;
+     d->comb2 = 0;
+     d->primed = 0;
+ }
+ 
+ /**
+  * @brief Fournit un échantillon brut à l'étage de décimation.
+  */
+ bool ADS1115_Decimator_push(ADS1115_Decimator *d, int16_t sample, int32_t *out) {
+     if (d == NULL || out == NULL || sample == INT16_MIN) {
+         return false;
+     }
+ 
+     switch (d->mode) {
+         case ADS1115_DECIM_BOXCAR: {
+             d->acc += sample;
+             if (++d->count < d->ratio) {
+                 return false;
+             }
+             // Moyenne du bloc en Q.8 : décalage si ratio = 2^shift, sinon division (une fois par sortie)
+             if (d->shift == 0xFF) {
+                 *out = (int32_t)(((int64_t)d->acc << ADS1115_DECIM_FRAC_BITS) / d->ratio);
+             } else if (d->shift >= ADS1115_DECIM_FRAC_BITS) {
+                 *out = d->acc >> (d->shift - ADS1115_DECIM_FRAC_BITS);
+             } else {
+                 *out = d->acc * (1 << (ADS1115_DECIM_FRAC_BITS - d->shift));
+             }
+             d->acc = 0;
+             d->count = 0;
+             return true;
+         }
+ 
+         case ADS1115_DECIM_CIC2: {
+             // Intégrateurs à la cadence d'entrée ; le débordement modulo 2^32 est compensé par les dérivateurs
+             d->integ1 += (uint32_t)(int32_t)sample;
+             d->integ2 += d->integ1;
+             if (++d->count < d->ratio) {
+                 return false;
+             }
+             d->count = 0;
+ 
+             // Dérivateurs à la cadence de sortie
+             uint32_t c1 = d->integ2 - d->comb1;
+             d->comb1 = d->integ2;
+             uint32_t c2 = c1 - d->comb2;
+             d->comb2 = c1;
+ 
+             // Les deux premières sorties ne couvrent pas encore une réponse impulsionnelle complète
+             if (d->primed < 2) {
+                 d->primed++;
+                 return false;
+             }
+ 
+             // Gain du CIC = ratio^2 = 2^(2*shift) : ramener en Q.8
+             int32_t y = (int32_t)c2;
+             uint8_t gainBits = (uint8_t)(2 * d->shift);
+             if (gainBits >= ADS1115_DECIM_FRAC_BITS) {
+                 *out = y >> (gainBits - ADS1115_DECIM_FRAC_BITS);
+             } else {
+                 *out = y * (1 << (ADS1115_DECIM_FRAC_BITS - gainBits));
+             }
+             return true;
+         }
+ 
+         case ADS1115_DECIM_MEDIAN: {
+             // Insertion triée : coût O(N) par échantillon au lieu d'un tri complet par sortie
+             uint16_t i = d->count;
+             while (i > 0 && d->window[i - 1] > sample) {
+                 d->window[i] = d->window[i - 1];
+                 i--;
+             }
+             d->window[i] = sample;
+             if (++d->count < d->ratio) {
+                 return false;
+             }
+             uint16_t mid = d->ratio / 2;
+             if (d->ratio & 1) {
+                 *out = (int32_t)d->window[mid] * (1 << ADS1115_DECIM_FRAC_BITS);
+             } else {
+                 // N pair : moyenne des deux valeurs centrales
+                 *out = ((int32_t)d->window[mid - 1] + d->window[mid]) * (1 << (ADS1115_DECIM_FRAC_BITS - 1));
+             }
+             d->count = 0;
+             return true;
+         }
+ 
+         default:
+             return false;
+     }
+ }
+ 
+ /**
+  * @brief Vide le tampon du mode Conversion Ready dans l'étage de décimation.
+  */
+ uint16_t ADS1115_Decimator_process(ADS1115_Decimator *d, int32_t *out, uint16_t maxOut) {
+     uint16_t produced = 0;
+     int16_t sample;
+ 
+     if (d == NULL || out == NULL) {
+         return 0;
+     }
+     while (produced < maxOut && ADS1115_readBuffered(&sample)) {
+         if (ADS1115_Decimator_push(d, sample, &out[produced])) {
+             produced++;
+         }
+     }
+     return produced;
+ }
+ 
+ #ifdef ADS1115_DECIM_BENCHMARK
+ /**
+  * @brief Mesure le coût CPU moyen d'un échantillon d'entrée.
+  */
+ uint32_t ADS1115_Decimator_benchmark(ADS1115_DecimMode mode, uint16_t ratio, uint32_t samples) {
+     ADS1115_Decimator d;
+     volatile int32_t sink = 0; // Empêche le compilateur d'éliminer la boucle
+     int32_t out;
+     uint32_t lcg = 12345u;     // Générateur pseudo-aléatoire (bruit autour d'une valeur fixe)
+ 
+     if (samples == 0 || !ADS1115_Decimator_init(&d, mode, ratio)) {
+         return 0;
+     }
+ 
+     uint32_t start = HAL_GetTick();
+     for (uint32_t n = 0; n < samples; n++) {
+         lcg = lcg * 1664525u + 1013904223u;
+         int16_t sample = (int16_t)(12000 + (int16_t)((lcg >> 16) & 0x03FF) - 512);
+         if (ADS1115_Decimator_push(&d, sample, &out)) {
+             sink += out;
+         }
+     }
+     uint32_t elapsed_ms = HAL_GetTick() - start;
+     (void)sink;
+ 
+     // cycles = ms * (cycles par ms) / échantillons (inclut la boucle et le générateur, quelques cycles)
+     return (uint32_t)(((uint64_t)elapsed_ms * (SystemCoreClock / 1000u)) / samples);
+ }
+ #endif
+ 
+ // --- Fonctions utilitaires internes ---
+ 
+ /**
+  * @brief Recalcule le mot de configuration en cache (comparateur désactivé, single-shot, gain et data rate du module).
+  *        Appelée uniquement quand le gain ou le data rate change : les lectures n'ont plus qu'à ajouter MUX et OS.
+  */
+ static void updateConfigCache(ADS1115_Handle *h) {
+     h->config = ADS1115_REG_CONFIG_CQUE_NONE |    // Désactiver la fonction de comparateur
+                 ADS1115_REG_CONFIG_CLAT_NONLAT |  // Non verrouillé
+                 ADS1115_REG_CONFIG_CPOL_ACTVLOW | // Alerte/Rdy actif bas (non pertinent si CQUE_NONE)
+                 ADS1115_REG_CONFIG_CMODE_TRAD |   // Mode traditionnel (non pertinent si CQUE_NONE)
+                 ADS1115_REG_CONFIG_MODE_SINGLE |  // Mode unique
+                 h->gain |                         // Gain du module
+                 h->dataRate;                      // Data rate du module
+ }
+ 
+ /**
+  * @brief Construit le mot de configuration à partir du cache pour un MUX et un mode donnés.
+  *        Le bit OS est positionné pour démarrer la conversion.
+  */
+ static uint16_t buildConfig(const ADS1115_Handle *h, uint16_t mux, bool continuous) {
+     uint16_t config = h->config | (mux & ADS1115_REG_CONFIG_MUX_MASK) | ADS1115_REG_CONFIG_OS_SINGLE;
+     if (continuous) {
+         config &= (uint16_t)~ADS1115_REG_CONFIG_MODE_MASK; // Mode continu (bit MODE à 0)
+     }
+     return config;
+ }
+ 
+ /**
+  * @brief Positionne le registre pointeur du module, sauf s'il désigne déjà le registre demandé.
+  */
+ static HAL_StatusTypeDef setPointer(ADS1115_Handle *h, uint8_t reg) {
+     if (h->pointer == reg) {
+         return HAL_OK; // Trame évitée
+     }
+ 
+     uint8_t reg_ptr = reg;
+     h->txCount++;
+     HAL_StatusTypeDef status = HAL_I2C_Master_Transmit(h->hi2c, h->address, &reg_ptr, 1, ADS1115_I2C_TIMEOUT_MS);
+     h->pointer = (status == HAL_OK) ? reg : ADS1115_REG_POINTER_UNKNOWN;
+     return status;
+ }
+ 
+ /**
+  * @brief true si le module est celui du mode Conversion Ready actif : seule l'interruption peut alors lui parler.
+  */
+ static bool isRdyLocked(const ADS1115_Handle *h) {
+     return ads_rdyActive && h == ads_rdyHandle;
+ }
+ 
+ /**
+  * @brief Convertit un numéro de canal single-ended (0-3) en réglage MUX.
+  */
+ static uint16_t channelToMux(uint8_t channel) {
+     return (uint16_t)(ADS1115_REG_CONFIG_MUX_SINGLE_0 + ((uint16_t)(channel & 0x03) << 12));
+ }
+ 
+ /**
+  * @brief Réinitialise la trame courante et lance le premier canal du masque sur chaque module.
+  */
+ static void scanStartFrame(void) {
+     for (uint8_t i = 0; i < MAX_ADS1115_MODULES; i++) {
+         for (uint8_t ch = 0; ch < ADS1115_SCAN_CHANNELS; ch++) {
+             ads_scanFrame.values[i][ch] = INT16_MIN;
+         }
+     }
+     ads_scanFrame.validMask = 0;
+     ads_scanFrame.timestamp = HAL_GetTick();
+ 
+     for (uint8_t i = 0; i < ads_moduleCount; i++) {
+         ads_scanSlots[i].state = ADS1115_SCAN_IDLE;
+         ads_scanSlots[i].channel = 0;
+         // Le premier canal du masque, ou le suivant si son démarrage échoue
+         for (uint8_t ch = 0; ch < ADS1115_SCAN_CHANNELS; ch++) {
+             if ((ads_scanMask & (1u << ch)) && scanStartChannel(i, ch)) {
+                 break;
+             }
+         }
+         if (ads_scanSlots[i].state != ADS1115_SCAN_CONVERTING) {
+             ads_scanSlots[i].state = ADS1115_SCAN_DONE; // Module injoignable pour cette trame
+         }
+     }
+ }
+ 
+ /**
+  * @brief Lance une conversion single-shot sur un canal d'un module du balayage.
+  */
+ static bool scanStartChannel(uint8_t moduleIndex, uint8_t channel) {
+     ADS1115_Handle *h = &ads_modules[moduleIndex];
+     ADS1115_ScanSlot *slot = &ads_scanSlots[moduleIndex];
+ 
+     if (!ADS1115_Handle_startADCReading(h, channelToMux(channel), false)) {
+         return false;
+     }
+ 
+     // Temps de conversion avec 10 % de tolérance sur l'oscillateur interne, arrondi au ms supérieur
+     uint16_t sps = ADS1115_getDataRateSPS(h->dataRate);
+     slot->readyMs = (1100u + sps - 1u) / sps;
+     slot->channel = channel;
+     slot->startTick = HAL_GetTick();
+     slot->state = ADS1115_SCAN_CONVERTING;
+     return true;
+ }
+ 
+ /**
+  * @brief Passe au canal suivant du masque pour un module, ou marque le module comme terminé pour cette trame.
+  */
+ static void scanAdvance(uint8_t moduleIndex) {
+     ADS1115_ScanSlot *slot = &ads_scanSlots[moduleIndex];
+     for (uint8_t ch = (uint8_t)(slot->channel + 1); ch < ADS1115_SCAN_CHANNELS; ch++) {
+         if ((ads_scanMask & (1u << ch)) && scanStartChannel(moduleIndex, ch)) {
+             return;
+         }
+     }
+     slot->state = ADS1115_SCAN_DONE;
+ }
+ 
+ /**
+  * @brief Fonction interne pour démarrer, attendre et lire la valeur ADC pour un réglage de multiplexeur donné.
+  *        Utilise IMPERATIVEMENT le mode unique (single-shot). Gère les erreurs I2C et timeout.
+  *        Utilisée par les fonctions readADC_SingleEnded et readADC_Differential_*.
+  */
+ static int16_t readADC(ADS1115_Handle *h, uint16_t mux_config) {
+     // Démarrer une conversion unique pour le canal donné
+     if (!ADS1115_Handle_startADCReading(h, mux_config, false)) { // false = mode unique
+         return INT16_MIN; // Erreur I2C lors du démarrage
+     }
+ 
+     // Récupérer le data rate du module pour calculer le timeout
+     uint16_t sps = ADS1115_getDataRateSPS(h->dataRate);
+     // Calculer le délai de conversion en ms, ajouter une marge (+2ms) et s'assurer qu'il n'est pas trop court
+     uint32_t conversion_delay_ms = 2 + (1000 / sps);
+     if (conversion_delay_ms < ADS1115_MIN_CONVERSIONDELAY) {
+         conversion_delay_ms = ADS1115_MIN_CONVERSIONDELAY;
+     }
+     // Définir un timeout légèrement plus long que le temps de conversion attendu (ex: 2x ou +10ms)
+     uint32_t timeout_ms = conversion_delay_ms + 10; // Ajout d'une marge fixe
+ 
+ 
+     // Attendre que la conversion soit terminée en interrogeant le bit OS
+     uint32_t start_time = HAL_GetTick();
+     int8_t conversion_status;
+     while (true) {
+         conversion_status = ADS1115_Handle_conversionComplete(h);
+ 
+         if (conversion_status == 1) { // Conversion terminée
+             break;
+         }
+         if (conversion_status == -1) { // Erreur I2C pendant la vérification
+              return INT16_MIN;
+         }
+         // Vérifier le timeout
+         uint32_t current_time = HAL_GetTick();
+         // Gérer le débordement du compteur HAL_GetTick()
+         uint32_t elapsed_time = (current_time >= start_time) ? (current_time - start_time) : (UINT32_MAX - start_time + current_time + 1);
+ 
+         if (elapsed_time > timeout_ms) {
+             // Gérer l'erreur de timeout
+             // printf("Timeout attente conversion!\r\n"); // Debug
+             return INT16_MIN; // Indiquer une erreur de timeout
+         }
+         // Petit délai optionnel pour ne pas surcharger le CPU/Bus, surtout si le timeout est long
+         // HAL_Delay(1); // Peut être nécessaire pour les data rates très lents, mais augmente la latence
+     }
+ 
+     // Lire les résultats de la conversion
+     int16_t result;
+     if (ADS1115_Handle_getLastConversionResults(h, &result)) {
+         return result;
+     } else {
+         return INT16_MIN; // Erreur I2C lors de la lecture du résultat
+     }
+ }
+ 
+ /**
+  * @brief Convertit la valeur du registre Data Rate en Samples Per Second (SPS).
+  */
+ static uint16_t ADS1115_getDataRateSPS(uint16_t dr_value) {
+     // Masquer les bits non pertinents pour être sûr
      dr_value &= ADS1115_REG_CONFIG_DR_MASK;
      switch (dr_value) {
          case ADS1115_REG_CONFIG_DR_8SPS:   return 8;
@@ -518,4 +1402,3 @@
          default: return 128; // Valeur par défaut si inconnue
      }
  }
- 
@@ -23,6 +23,33 @@
  #define ADS1115_MIN_CONVERSIONDELAY (2) // Délai minimum absolu (plus rapide que 860 SPS)
  /*=========================================================================*/
  
+ /*=========================================================================
+     CONVERSION READY (ALERT/RDY) - Taille du tampon circulaire
+     -----------------------------------------------------------------------*/
+ #ifndef ADS1115_RDY_BUFFER_SIZE
+ #define ADS1115_RDY_BUFFER_SIZE (64) // Nombre d'échantillons stockés (doit être une puissance de 2)
+ #endif
+ /*=========================================================================*/
+ 
+ /*=========================================================================
+     DÉCIMATION (suréchantillonnage et filtrage)
+     -----------------------------------------------------------------------*/
+ #ifndef ADS1115_DECIM_MEDIAN_MAX
+ #define ADS1115_DECIM_MEDIAN_MAX (15) // Taille maximale de la fenêtre du filtre médian
+ #endif
+ #define ADS1115_DECIM_FRAC_BITS (8)   // Bits fractionnaires des sorties filtrées (comptes ADC en Q.8)
+ #define ADS1115_DECIM_CIC2_RATIO_MAX (256) // Rapport max du CIC d'ordre 2 (16 + 2*8 bits = 32 bits de registre)
+ // #define ADS1115_DECIM_BENCHMARK // Décommenter pour compiler ADS1115_Decimator_benchmark()
+ /*=========================================================================*/
+ 
+ /*=========================================================================
+     AUTO-RANGING DU PGA (en comptes ADC absolus)
+     -----------------------------------------------------------------------*/
+ #define ADS1115_AUTORANGE_HIGH (30000) // |comptes| >= seuil : passer à la plage supérieure (~92 % de la pleine échelle)
+ #define ADS1115_AUTORANGE_LOW (13000)  // |comptes| < seuil : la plage inférieure donnerait < 26000 comptes, marge d'hystérésis
+ #define ADS1115_AUTORANGE_HOLD (4)     // Lectures consécutives sous le seuil bas avant de réduire la plage
+ /*=========================================================================*/
+ 
  /*=========================================================================
      POINTER REGISTER
      -----------------------------------------------------------------------*/
@@ -31,6 +58,7 @@
  #define ADS1115_REG_POINTER_CONFIG (0x01)  ///< Configuration register
  #define ADS1115_REG_POINTER_LOWTHRESH (0x02) ///< Lo-thresh register
  #define ADS1115_REG_POINTER_HITHRESH (0x03) ///< Hi-thresh register
+ #define ADS1115_REG_POINTER_UNKNOWN (0xFF) ///< Valeur du registre pointeur inconnue (après init ou erreur I2C)
  /*=========================================================================*/
  
  /*=========================================================================
@@ -91,6 +119,15 @@
  #define ADS1115_REG_CONFIG_CQUE_NONE (0x0003) ///< Disable the comparator and put ALERT/RDY in high state (default)
  /*=========================================================================*/
  
+ /*=========================================================================
+     THRESHOLD REGISTERS
+     -----------------------------------------------------------------------*/
+ #define ADS1115_LOWTHRESH_DEFAULT (0x8000) ///< Valeur au reset du registre Lo_thresh
+ #define ADS1115_HITHRESH_DEFAULT (0x7FFF)  ///< Valeur au reset du registre Hi_thresh
+ #define ADS1115_LOWTHRESH_RDY (0x0000)     ///< MSB de Lo_thresh à 0 : active le mode conversion-ready
+ #define ADS1115_HITHRESH_RDY (0x8000)      ///< MSB de Hi_thresh à 1 : active le mode conversion-ready
+ /*=========================================================================*/
+ 
  /* Gain settings */
  typedef enum {
    GAIN_TWOTHIRDS = ADS1115_REG_CONFIG_PGA_6_144V, ///< +/- 6.144V range -> 1 bit = 0.1875 mV (limited to VDD +0.3V max!)
@@ -103,13 +140,217 @@
  
  #define MAX_ADS1115_MODULES 4 // Nombre maximum de modules pris en charge
  
- // Structure pour stocker l'état de chaque module
+ #define ADS1115_SCAN_CHANNELS 4 // Nombre de canaux single-ended par module (AIN0 à AIN3)
+ #define ADS1115_SCAN_TIMEOUT_MS (10) // Marge ajoutée au temps de conversion avant de déclarer un canal en erreur
+ 
+ // Handle d'un module ADS1115 : porte tout l'état nécessaire à une transaction,
+ // ce qui permet d'utiliser plusieurs modules depuis des contextes différents (tâches RTOS, interruption).
  typedef struct {
+     I2C_HandleTypeDef *hi2c;       // Bus I2C sur lequel se trouve le module
      uint8_t address;               // Adresse I2C du module (déjà décalée pour HAL)
      adsGain_t gain;                // Gain actuel pour ce module
      uint16_t dataRate;             // Taux d'échantillonnage actuel pour ce module
+     uint16_t config;               // Mot de configuration précalculé (single-shot, sans MUX ni OS), mis à jour par setGain/setDataRate
+     uint16_t lastConfig;           // Dernier mot écrit dans le registre de configuration du module (bit OS exclu)
+     uint8_t pointer;               // Valeur actuelle du registre pointeur du module (ADS1115_REG_POINTER_UNKNOWN si inconnue)
+     bool lastConfigValid;          // true si lastConfig reflète le contenu du module
+     uint32_t txCount;              // Nombre de transactions I2C émises vers ce module (code principal)
+     volatile uint32_t isrTxCount;  // Transactions émises par ADS1115_conversionReadyCallback (interruption uniquement)
+     bool autoRange;                // true si le gain est ajusté automatiquement après chaque lecture
+     adsGain_t autoRangeWidest;     // Plage la plus large autorisée en auto-ranging (limite liée à VDD)
+     uint8_t autoRangeLowCount;     // Lectures consécutives sous ADS1115_AUTORANGE_LOW
      bool initialized;              // Indicateur si le module a été ajouté
- } ADS1115_Module;
+ } ADS1115_Handle;
+ 
+ typedef ADS1115_Handle ADS1115_Module; // Ancien nom conservé pour compatibilité
+ 
+ // Type de filtre de décimation
+ typedef enum {
+     ADS1115_DECIM_BOXCAR = 0, // Moyenne par blocs de N (CIC d'ordre 1), tout rapport de 1 à 65535
+     ADS1115_DECIM_CIC2,       // CIC d'ordre 2 (meilleure réjection du repliement), rapport puissance de 2 <= ADS1115_DECIM_CIC2_RATIO_MAX
+     ADS1115_DECIM_MEDIAN      // Médiane de N par blocs (rejet des pics), N <= ADS1115_DECIM_MEDIAN_MAX
+ } ADS1115_DecimMode;
+ 
+ // État d'un étage de décimation (un par canal filtré)
+ typedef struct {
+     ADS1115_DecimMode mode;        // Type de filtre
+     uint16_t ratio;                // Nombre d'échantillons d'entrée par sortie
+     uint8_t shift;                 // log2(ratio) si ratio est une puissance de 2, sinon 0xFF
+     uint16_t count;                // Échantillons reçus dans le bloc courant
+     int32_t acc;                   // Boxcar : somme du bloc
+     uint32_t integ1, integ2;       // CIC2 : intégrateurs (arithmétique modulo 2^32)
+     uint32_t comb1, comb2;         // CIC2 : mémoires des dérivateurs
+     uint8_t primed;                // CIC2 : sorties ignorées pendant le régime transitoire
+     int16_t window[ADS1115_DECIM_MEDIAN_MAX]; // Médian : échantillons du bloc, maintenus triés
+ } ADS1115_Decimator;
+ 
+ // Trame de résultats produite par le balayage multi-modules
+ typedef struct {
+     int16_t values[MAX_ADS1115_MODULES][ADS1115_SCAN_CHANNELS]; // Lectures brutes [module][canal], INT16_MIN si invalide
+     uint16_t validMask;            // Bit (module * 4 + canal) à 1 si la lecture correspondante est valide
+     uint32_t timestamp;            // HAL_GetTick() au démarrage de l'acquisition de la trame
+ } ADS1115_ScanFrame;
+ 
+ // --- API par handle ---
+ // Chaque fonction ADS1115_Handle_xxx() agit uniquement sur le handle fourni : aucun état global n'est lu ou modifié.
+ // Deux handles peuvent donc être utilisés en parallèle depuis deux contextes, à condition que l'accès au bus I2C
+ // lui-même soit sérialisé (HAL retourne HAL_BUSY si le bus est déjà occupé).
+ 
+ /**
+  * @brief Initialise un handle ADS1115 (gain GAIN_TWOTHIRDS, 128 SPS) sans communiquer avec le module.
+  * @param h Pointeur vers le handle à initialiser.
+  * @param hi2c Pointeur vers la structure HAL I2C handle du bus.
+  * @param address Adresse I2C 7 bits du module (ex: 0x48).
+  * @return true si le handle est initialisé, false si un pointeur est NULL.
+  */
+ bool ADS1115_Handle_init(ADS1115_Handle *h, I2C_HandleTypeDef *hi2c, uint8_t address);
+ 
+ /**
+  * @brief Vérifie si le module est connecté et réactif (lecture du registre de configuration).
+  */
+ bool ADS1115_Handle_begin(ADS1115_Handle *h);
+ 
+ /**
+  * @brief Définit le gain du module. Le mot de configuration en cache est recalculé ici, pas à chaque lecture.
+  */
+ void ADS1115_Handle_setGain(ADS1115_Handle *h, adsGain_t gain);
+ 
+ /**
+  * @brief Récupère le gain du module, ou GAIN_TWOTHIRDS si le handle est invalide.
+  */
+ adsGain_t ADS1115_Handle_getGain(const ADS1115_Handle *h);
+ 
+ /**
+  * @brief Définit le taux d'échantillonnage du module (constantes ADS1115_REG_CONFIG_DR_*). Recalcule le mot de configuration en cache.
+  */
+ void ADS1115_Handle_setDataRate(ADS1115_Handle *h, uint16_t rate);
+ 
+ /**
+  * @brief Récupère le taux d'échantillonnage du module, ou ADS1115_REG_CONFIG_DR_128SPS si le handle est invalide.
+  */
+ uint16_t ADS1115_Handle_getDataRate(const ADS1115_Handle *h);
+ 
+ /**
+  * @brief Lecture single-shot d'un canal single-ended (0-3).
+  * @return La lecture ADC, ou INT16_MIN si le canal ou le handle est invalide, en cas d'erreur I2C ou de timeout.
+  */
+ int16_t ADS1115_Handle_readADC_SingleEnded(ADS1115_Handle *h, uint8_t channel);
+ 
+ /**
+  * @brief Lecture single-shot d'une paire différentielle.
+  * @param mux ADS1115_REG_CONFIG_MUX_DIFF_0_1, _0_3, _1_3 ou _2_3.
+  * @return La lecture ADC, ou INT16_MIN si le MUX ou le handle est invalide, en cas d'erreur I2C ou de timeout.
+  */
+ int16_t ADS1115_Handle_readADC_Differential(ADS1115_Handle *h, uint16_t mux);
+ 
+ /**
+  * @brief Démarre le mode comparateur sur le module (voir `ADS1115_startComparator_SingleEnded()`).
+  */
+ bool ADS1115_Handle_startComparator_SingleEnded(ADS1115_Handle *h, uint8_t channel, int16_t lowThreshold, int16_t highThreshold,
+                                                 uint16_t compMode, uint16_t compPol, uint16_t compLat, uint16_t compQue);
+ 
+ /**
+  * @brief Lit le dernier résultat de conversion du module (voir `ADS1115_getLastConversionResults()`).
+  */
+ bool ADS1115_Handle_getLastConversionResults(ADS1115_Handle *h, int16_t *value);
+ 
+ /**
+  * @brief Convertit des comptes bruts en volts selon le gain du module. Retourne 0.0f si le handle est invalide ou counts == INT16_MIN.
+  */
+ float ADS1115_Handle_computeVolts(const ADS1115_Handle *h, int16_t counts);
+ 
+ /**
+  * @brief Convertit des comptes bruts en millivolts selon le gain du module. Retourne 0.0f si le handle est invalide ou counts == INT16_MIN.
+  */
+ float ADS1115_Handle_computeMilliVolts(const ADS1115_Handle *h, int16_t counts);
+ 
+ /**
+  * @brief Convertit des comptes bruts en microvolts selon le gain du module, en arithmétique entière.
+  * @return La tension en µV, ou 0 si le handle est invalide ou counts == INT16_MIN.
+  */
+ int32_t ADS1115_Handle_computeMicroVolts(const ADS1115_Handle *h, int16_t counts);
+ 
+ /**
+  * @brief Active ou désactive l'auto-ranging du PGA pour le module.
+  *        Après chaque lecture faite avec `ADS1115_Handle_readMicroVolts()` (ou signalée via `ADS1115_Handle_autoRangeUpdate()`),
+  *        le gain est réduit d'un cran dès que |comptes| >= ADS1115_AUTORANGE_HIGH, et augmenté d'un cran après
+  *        ADS1115_AUTORANGE_HOLD lectures consécutives sous ADS1115_AUTORANGE_LOW. Aucune conversion supplémentaire.
+  * @note Prévu pour un seul canal par handle : le gain suit le dernier signal lu.
+  * @param enable true pour activer, false pour désactiver (le gain courant est conservé).
+  * @param widestGain Plage la plus large autorisée (ex: GAIN_ONE si VDD = 3.3V, pour rester sous VDD + 0.3V).
+  */
+ void ADS1115_Handle_setAutoRange(ADS1115_Handle *h, bool enable, adsGain_t widestGain);
+ 
+ /**
+  * @brief Met à jour l'auto-ranging avec une lecture obtenue par ailleurs (mode continu, tampon Conversion Ready...).
+  * @note En mode continu, un changement de gain ne prend effet qu'au prochain `ADS1115_Handle_startADCReading()`.
+  * @return true si le gain a changé, false sinon (ou si l'auto-ranging est désactivé).
+  */
+ bool ADS1115_Handle_autoRangeUpdate(ADS1115_Handle *h, int16_t counts);
+ 
+ /**
+  * @brief Lecture single-shot convertie en microvolts avec le gain utilisé pour la conversion, puis mise à jour de l'auto-ranging.
+  * @param mux Réglage MUX (constantes ADS1115_REG_CONFIG_MUX_*).
+  * @param microVolts Pointeur où écrire la tension en µV.
+  * @return true si la lecture a réussi, false en cas d'erreur I2C ou de timeout (`*microVolts` non modifié).
+  *         Une lecture saturée (|comptes| >= 32767) est tout de même retournée ; la suivante se fera sur une plage plus large.
+  */
+ bool ADS1115_Handle_readMicroVolts(ADS1115_Handle *h, uint16_t mux, int32_t *microVolts);
+ 
+ /**
+  * @brief Démarre une conversion (single-shot ou continue) à partir du mot de configuration en cache.
+  * @note En mode continu, l'écriture est omise si le module tourne déjà avec exactement la même configuration.
+  *       En single-shot, l'écriture reste nécessaire : c'est elle qui positionne le bit OS.
+  */
+ bool ADS1115_Handle_startADCReading(ADS1115_Handle *h, uint16_t mux, bool continuous);
+ 
+ /**
+  * @brief Vérifie le bit OS du module : 1 si la conversion est terminée, 0 si elle est en cours, -1 en cas d'erreur.
+  */
+ int8_t ADS1115_Handle_conversionComplete(ADS1115_Handle *h);
+ 
+ /**
+  * @brief Démarre le mode Conversion Ready sur le module (voir `ADS1115_startConversionReady()`).
+  *        Le handle doit rester valide (ne pas être une variable locale) tant que le mode est actif.
+  *        Pendant ce temps, les lectures/écritures de registre sur ce handle renvoient HAL_BUSY :
+  *        elles déplaceraient le registre pointeur que l'interruption suppose sur CONVERT.
+  */
+ bool ADS1115_Handle_startConversionReady(ADS1115_Handle *h, uint16_t mux, uint16_t compPol);
+ 
+ /**
+  * @brief Retourne le nombre de transactions I2C (trames adressées) émises vers le module depuis l'init ou la dernière remise à zéro.
+  *        Permet de mesurer l'effet du suivi du registre pointeur et de l'élision des écritures de configuration.
+  *        Inclut les lectures faites par `ADS1115_conversionReadyCallback()`, comptées séparément.
+  */
+ uint32_t ADS1115_Handle_getTransactionCount(const ADS1115_Handle *h);
+ 
+ /**
+  * @brief Remet à zéro le compteur de transactions I2C du module.
+  */
+ void ADS1115_Handle_resetTransactionCount(ADS1115_Handle *h);
+ 
+ /**
+  * @brief Oublie l'état supposé du module (registre pointeur et dernière configuration).
+  *        À appeler si le module a pu être modifié hors du pilote (reset, autre maître I2C) :
+  *        la prochaine lecture renverra le pointeur et la prochaine configuration sera écrite.
+  */
+ void ADS1115_Handle_invalidateCache(ADS1115_Handle *h);
+ 
+ /**
+  * @brief Écrit 16 bits dans un registre du module.
+  */
+ HAL_StatusTypeDef ADS1115_Handle_writeRegister(ADS1115_Handle *h, uint8_t reg, uint16_t value);
+ 
+ /**
+  * @brief Lit 16 bits depuis un registre du module. `*value` est mis à 0 en cas d'erreur.
+  * @note La trame d'écriture du pointeur n'est émise que si le registre pointeur du module désigne un autre registre :
+  *       interroger le bit OS juste après l'écriture de la configuration, ou relire le registre de conversion
+  *       en mode continu, ne coûte qu'une trame de lecture.
+  */
+ HAL_StatusTypeDef ADS1115_Handle_readRegister(ADS1115_Handle *h, uint8_t reg, uint16_t *value);
+ 
+ // --- API globale (module sélectionné) ---
+ // Conservée pour compatibilité : chaque fonction appelle son équivalent ADS1115_Handle_xxx() sur le module sélectionné.
  
  /**
   * @brief Initialise le pilote ADS1115 globalement (stocke le handle I2C).
@@ -131,6 +372,13 @@
   */
  bool ADS1115_selectModule(uint8_t moduleIndex);
  
+ /**
+  * @brief Retourne le handle d'un module ajouté avec `ADS1115_addModule()`, pour l'utiliser avec l'API par handle.
+  * @param moduleIndex Index du module (0 à MAX_ADS1115_MODULES - 1).
+  * @return Pointeur vers le handle du module, ou NULL si l'index est invalide.
+  */
+ ADS1115_Handle *ADS1115_getModuleHandle(uint8_t moduleIndex);
+ 
  /**
   * @brief Récupère l'adresse I2C (décalée pour HAL) du module actuellement sélectionné.
   * @return Adresse I2C 8 bits du module sélectionné, ou 0 si aucun module valide n'est sélectionné.
@@ -248,6 +496,20 @@
   */
  float ADS1115_computeMilliVolts(int16_t counts);
  
+ /**
+  * @brief Convertit des comptes bruts en microvolts pour un gain donné, sans calcul flottant.
+  *        Utilise une table de pas (µV x 16) par gain : µV = (comptes * pas + 8) >> 4, exact pour tous les gains.
+  * @note Pas du datasheet (pleine échelle / 32768), là où `ADS1115_computeVolts()` divise par 32767 (écart de 0.003 %).
+  * @return La tension en µV, ou 0 si counts == INT16_MIN.
+  */
+ int32_t ADS1115_countsToMicroVolts(int16_t counts, adsGain_t gain);
+ 
+ /**
+  * @brief Calcule la tension en microvolts (entier) selon le gain du module *actuellement sélectionné*.
+  * @return La tension en µV, ou 0 si aucun module valide n'est sélectionné ou si counts indique une erreur.
+  */
+ int32_t ADS1115_computeMicroVolts(int16_t counts);
+ 
  /**
   * @brief Démarre une conversion ADC (mode unique ou continu) pour le module *actuellement sélectionné*.
   *        En mode unique, utiliser les fonctions `readADC_...` qui gèrent l'attente.
@@ -260,6 +522,16 @@
   */
  bool ADS1115_startADCReading(uint16_t mux, bool continuous);
  
+ /**
+  * @brief Retourne le nombre de transactions I2C émises vers le module *actuellement sélectionné* (0 si aucun module n'est sélectionné).
+  */
+ uint32_t ADS1115_getTransactionCount(void);
+ 
+ /**
+  * @brief Remet à zéro le compteur de transactions I2C du module *actuellement sélectionné*.
+  */
+ void ADS1115_resetTransactionCount(void);
+ 
  /**
   * @brief Vérifie si une conversion ADC est terminée pour le module *actuellement sélectionné*.
   *        Lit le bit OS du registre de configuration.
@@ -267,6 +539,141 @@
   */
  int8_t ADS1115_conversionComplete(void);
  
+ // --- Mode Conversion Ready (ALERT/RDY piloté par interruption) ---
+ 
+ /**
+  * @brief Démarre le mode continu avec la broche ALERT/RDY en signal "conversion prête" pour le module *actuellement sélectionné*.
+  *        Les registres de seuil sont chargés avec le motif RDY (Lo_thresh MSB = 0, Hi_thresh MSB = 1) :
+  *        la broche ALERT/RDY émet alors une impulsion à la fin de chaque conversion.
+  *        Le registre pointeur est laissé sur le registre de conversion, ce qui permet à
+  *        `ADS1115_conversionReadyCallback()` de lire chaque résultat sans aucune trame de pointeur ni interrogation du bit OS.
+  * @note Configurer la broche reliée à ALERT/RDY en EXTI (front descendant pour ADS1115_REG_CONFIG_CPOL_ACTVLOW).
+  *       Le tampon circulaire est vidé au démarrage. Tant que le mode est actif, les accès registre à ce module
+  *       sont refusés (HAL_BUSY) car ils déplaceraient le registre pointeur : appeler `ADS1115_stopConversionReady()` d'abord.
+  * @param mux Réglage MUX (utiliser les constantes ADS1115_REG_CONFIG_MUX_*).
+  * @param compPol Polarité de la broche ALERT/RDY (ADS1115_REG_CONFIG_CPOL_ACTVLOW ou ADS1115_REG_CONFIG_CPOL_ACTVHI).
+  * @return true si la configuration a réussi, false en cas d'erreur I2C, si aucun module n'est sélectionné ou si un balayage est en cours.
+  */
+ bool ADS1115_startConversionReady(uint16_t mux, uint16_t compPol);
+ 
+ /**
+  * @brief Arrête le mode Conversion Ready : remet le module en mode single-shot (veille), désactive ALERT/RDY
+  *        et restaure les seuils par défaut. Les échantillons déjà dans le tampon restent lisibles.
+  * @return true si l'arrêt a réussi, false en cas d'erreur I2C ou si le mode n'était pas actif.
+  */
+ bool ADS1115_stopConversionReady(void);
+ 
+ /**
+  * @brief À appeler depuis `HAL_GPIO_EXTI_Callback()` sur la broche ALERT/RDY.
+  *        Lit le registre de conversion (2 octets, sans trame de pointeur) et place le résultat dans le tampon circulaire.
+  * @note Utilise l'adresse mémorisée au démarrage : ne dépend pas du module sélectionné.
+  *       Si le tampon est plein, si la lecture I2C échoue ou si le pointeur du module n'est plus sur CONVERT
+  *       (cache invalidé), l'échantillon est perdu et compté (voir `ADS1115_getDroppedSamples()`).
+  */
+ void ADS1115_conversionReadyCallback(void);
+ 
+ /**
+  * @brief Retourne le nombre d'échantillons disponibles dans le tampon circulaire.
+  */
+ uint16_t ADS1115_available(void);
+ 
+ /**
+  * @brief Retire l'échantillon le plus ancien du tampon circulaire.
+  * @param value Pointeur vers un int16_t où stocker la valeur lue.
+  * @return true si un échantillon a été lu, false si le tampon est vide ou si `value` est NULL.
+  */
+ bool ADS1115_readBuffered(int16_t *value);
+ 
+ /**
+  * @brief Retourne le nombre d'échantillons perdus (tampon plein ou erreur I2C dans l'interruption) depuis le dernier démarrage.
+  */
+ uint32_t ADS1115_getDroppedSamples(void);
+ 
+ // --- Balayage multi-modules (round-robin) ---
+ 
+ /**
+  * @brief Démarre le balayage des canaux single-ended sur tous les modules ajoutés.
+  *        Une conversion single-shot est lancée en parallèle sur chaque module ; chaque module est ensuite
+  *        servi dans l'ordre de fin de conversion par `ADS1115_scanPoll()`, qui lit le résultat et lance
+  *        immédiatement la conversion du canal suivant sur ce module (rotation du MUX).
+  *        Le débit d'une trame est donc celui des modules en parallèle, pas la somme des conversions.
+  * @note Utilise le gain et le data rate propres à chaque module. Indépendant du module sélectionné.
+  *       Le bus n'est interrogé (bit OS) qu'une fois le temps de conversion théorique écoulé.
+  * @param channelMask Canaux à balayer sur chaque module (bit 0 = AIN0 ... bit 3 = AIN3).
+  * @return true si au moins un module a démarré, false si le masque est vide, aucun module n'est ajouté,
+  *         ou si le mode Conversion Ready est actif.
+  */
+ bool ADS1115_scanStart(uint8_t channelMask);
+ 
+ /**
+  * @brief Fait avancer le balayage sans bloquer. À appeler régulièrement depuis la boucle principale.
+  *        Lorsqu'une trame est complète, elle est copiée dans `frame` et la trame suivante démarre aussitôt.
+  * @param frame Pointeur vers la trame à remplir (peut être NULL pour ignorer la trame).
+  * @return true si une trame complète vient d'être produite, false sinon.
+  */
+ bool ADS1115_scanPoll(ADS1115_ScanFrame *frame);
+ 
+ /**
+  * @brief Attend la prochaine trame complète du balayage (version bloquante de `ADS1115_scanPoll()`).
+  * @param frame Pointeur vers la trame à remplir.
+  * @param timeout_ms Temps d'attente maximum en ms.
+  * @return true si une trame a été produite, false en cas de timeout ou si le balayage n'est pas démarré.
+  */
+ bool ADS1115_scanReadFrame(ADS1115_ScanFrame *frame, uint32_t timeout_ms);
+ 
+ /**
+  * @brief Arrête le balayage. Les conversions en cours se terminent d'elles-mêmes (mode single-shot).
+  */
+ void ADS1115_scanStop(void);
+ 
+ // --- Décimation (suréchantillonnage) ---
+ // Les sorties sont en comptes ADC au format Q.ADS1115_DECIM_FRAC_BITS (valeur / 256 = comptes) : moyenner 4^k
+ // échantillons apporte k bits de résolution que ce format conserve. Calculs entiers uniquement.
+ // Débit de sortie = débit de l'ADC / ratio (ex: 860 SPS / 64 = 13.4 sorties/s).
+ 
+ /**
+  * @brief Initialise un étage de décimation.
+  * @param d Pointeur vers l'étage à initialiser.
+  * @param mode Type de filtre (ADS1115_DECIM_BOXCAR, ADS1115_DECIM_CIC2 ou ADS1115_DECIM_MEDIAN).
+  * @param ratio Nombre d'échantillons d'entrée par sortie.
+  * @return true si la configuration est valide, false sinon (ratio nul, ratio CIC2 non puissance de 2 ou trop grand,
+  *         fenêtre médiane supérieure à ADS1115_DECIM_MEDIAN_MAX).
+  */
+ bool ADS1115_Decimator_init(ADS1115_Decimator *d, ADS1115_DecimMode mode, uint16_t ratio);
+ 
+ /**
+  * @brief Remet à zéro l'état du filtre sans changer sa configuration.
+  */
+ void ADS1115_Decimator_reset(ADS1115_Decimator *d);
+ 
+ /**
+  * @brief Fournit un échantillon brut à l'étage de décimation.
+  * @param d Pointeur vers l'étage.
+  * @param sample Lecture ADC brute. Les valeurs INT16_MIN (erreur de lecture) sont ignorées.
+  * @param out Pointeur où écrire la sortie filtrée (Q.8) quand elle est produite.
+  * @return true si une nouvelle sortie a été écrite dans `out`, false sinon.
+  */
+ bool ADS1115_Decimator_push(ADS1115_Decimator *d, int16_t sample, int32_t *out);
+ 
+ /**
+  * @brief Vide le tampon du mode Conversion Ready dans l'étage de décimation.
+  * @param d Pointeur vers l'étage.
+  * @param out Tableau recevant les sorties filtrées (Q.8).
+  * @param maxOut Taille du tableau `out`. Le vidage s'arrête quand il est plein.
+  * @return Nombre de sorties écrites dans `out`.
+  */
+ uint16_t ADS1115_Decimator_process(ADS1115_Decimator *d, int32_t *out, uint16_t maxOut);
+ 
+ #ifdef ADS1115_DECIM_BENCHMARK
+ /**
+  * @brief Mesure le coût CPU moyen d'un échantillon d'entrée (cycles) pour un filtre donné.
+  *        Pousse `samples` échantillons pseudo-aléatoires et chronomètre avec HAL_GetTick() :
+  *        utiliser au moins 100000 échantillons pour une résolution correcte. Aucun accès I2C.
+  * @return Nombre moyen de cycles CPU par échantillon d'entrée (0 si la configuration est invalide).
+  */
+ uint32_t ADS1115_Decimator_benchmark(ADS1115_DecimMode mode, uint16_t ratio, uint32_t samples);
+ #endif
+ 
  // --- Fonctions I2C de bas niveau (utilisées en interne et potentiellement externe) ---
  
  /**
@@ -1,4 +1,5 @@
 #include "STM32_AHT20.h"
+#include "STM32_CRC8.h" // CRC8 partagé (dossier STM32_CRC8)
 
 /**
  * @brief Initialise le capteur AHT20
@@ -85,46 +86,89 @@ AHT20_Status AHT20_GetStatus(I2C_HandleTypeDef *hi2c, uint8_t *status) {
     return AHT20_OK;
 }
 
-static uint8_t AHT20_CalculateChecksum(uint8_t *data, uint8_t len) {
-    uint8_t crc = 0xFF; // Initialisation du CRC
-    for (uint8_t i = 0; i < len; i++) {
-        crc ^= data[i];
-        for (uint8_t j = 0; j < 8; j++) {
-            if (crc & 0x80) {
-                crc = (crc << 1) ^ 0x31; // Polynôme 0x31
-            } else {
-                crc <<= 1;
-            }
+/**
+ * @brief Vérifie une trame de mesure (statut, humidité, température, CRC) et la convertit
+ * @param buffer Trame de 7 octets lue après une mesure
+ * @param data Pointeur vers une structure pour stocker les mesures
+ * @return Statut de l'opération
+ */
+static AHT20_Status AHT20_ParseFrame(const uint8_t *buffer, AHT20_Data *data) {
+    uint32_t raw_humidity, raw_temperature;
+
+    // Vérifier si le capteur est occupé (bit 7 de l'octet de statut buffer[0])
+    if (buffer[0] & 0x80) {
+        return AHT20_ERROR_BUSY;
+    }
+
+    // Vérifier le checksum (sur les 6 premiers octets: Statut, H_data, T_data)
+    uint8_t calculated_crc = CRC8_Poly31(buffer, 6, 0xFF); // Polynôme 0x31, init 0xFF
+    if (calculated_crc != buffer[6]) {
+        printf("Checksum invalide. Données reçues: ");
+        for (int i = 0; i < 7; i++) {
+            printf("0x%02X ", buffer[i]);
         }
+        printf("\r\nChecksum attendu: 0x%02X, Calculé: 0x%02X\r\n", buffer[6], calculated_crc);
+        return AHT20_ERROR_CHECKSUM;
     }
-    return crc;
+
+    // Convertir les données
+    raw_humidity = ((buffer[1] << 12) | (buffer[2] << 4) | (buffer[3] >> 4));
+    raw_temperature = ((buffer[3] & 0x0F) << 16) | (buffer[4] << 8) | buffer[5];
+
+    data->humidity = (raw_humidity * 100.0) / 1048576.0;
+    data->temperature = ((raw_temperature * 200.0) / 1048576.0) - 50.0;
+
+    return AHT20_OK;
 }
 
 /**
- * @brief Lit les mesures de température et d'humidité
+ * @brief Déclenche une mesure sans attendre sa fin
  * @param hi2c Pointeur vers la structure de handle I2C
- * @param data Pointeur vers une structure pour stocker les mesures
+ * @param ready_tick Reçoit l'instant (HAL_GetTick) à partir duquel la mesure est prête (peut être NULL)
  * @return Statut de l'opération
  */
-AHT20_Status AHT20_ReadMeasurements(I2C_HandleTypeDef *hi2c, AHT20_Data *data) {
+AHT20_Status AHT20_TriggerMeasurement(I2C_HandleTypeDef *hi2c, uint32_t *ready_tick) {
     uint8_t cmd[3] = {AHT20_CMD_TRIGGER, AHT20_MEASURE_PARAM1, AHT20_MEASURE_PARAM2};
-    uint8_t buffer[7];
     HAL_StatusTypeDef hal_status;
-    uint32_t raw_humidity, raw_temperature;
 
-    if (hi2c == NULL || data == NULL) {
+    if (hi2c == NULL) {
         return AHT20_ERROR_INVALID_PARAM;
     }
 
-    // Envoyer la commande de mesure
     hal_status = HAL_I2C_Master_Transmit(hi2c, AHT20_I2C_ADDR, cmd, 3, AHT20_I2C_TIMEOUT_MS);
     if (hal_status != HAL_OK) {
         printf("Erreur I2C lors de la transmission: %d\r\n", hal_status);
         return AHT20_ERROR_I2C;
     }
 
-    // Attendre la fin de la mesure (datasheet: >=75ms, on utilise 80ms)
-    HAL_Delay(AHT20_DELAY_MEASUREMENT_WAIT_MS);
+    if (ready_tick != NULL) {
+        *ready_tick = HAL_GetTick() + AHT20_DELAY_MEASUREMENT_WAIT_MS;
+    }
+    return AHT20_OK;
+}
+
+/**
+ * @brief Indique si l'instant de disponibilité d'une mesure est atteint
+ * @param ready_tick Valeur fournie par AHT20_TriggerMeasurement
+ * @return 1 si la mesure peut être collectée, 0 sinon
+ */
+uint8_t AHT20_IsReady(uint32_t ready_tick) {
+    return (int32_t)(HAL_GetTick() - ready_tick) >= 0;
+}
+
+/**
+ * @brief Lit le résultat d'une mesure déclenchée par AHT20_TriggerMeasurement
+ * @param hi2c Pointeur vers la structure de handle I2C
+ * @param data Pointeur vers une structure pour stocker les mesures
+ * @return Statut de l'opération (AHT20_ERROR_BUSY si la conversion n'est pas terminée)
+ */
+AHT20_Status AHT20_CollectMeasurements(I2C_HandleTypeDef *hi2c, AHT20_Data *data) {
+    uint8_t buffer[7];
+    HAL_StatusTypeDef hal_status;
+
+    if (hi2c == NULL || data == NULL) {
+        return AHT20_ERROR_INVALID_PARAM;
+    }
 
     // Lire les données (7 octets: Statut, H1, H2, H3, T1, T2, CRC)
     hal_status = HAL_I2C_Master_Receive(hi2c, AHT20_I2C_ADDR, buffer, 7, AHT20_I2C_TIMEOUT_MS);
@@ -133,29 +177,224 @@ AHT20_Status AHT20_ReadMeasurements(I2C_HandleTypeDef *hi2c, AHT20_Data *data) {
         return AHT20_ERROR_I2C;
     }
 
-    // Vérifier si le capteur est occupé (bit 7 de l'octet de statut buffer[0])
-    if (buffer[0] & 0x80) {
-        printf("Capteur occupé, statut: 0x%02X\r\n", buffer[0]);
+    return AHT20_ParseFrame(buffer, data);
+}
+
+/**
+ * @brief Collecte la mesure seulement si le bit busy est retombé (lecture d'un octet sinon)
+ * @param hi2c Pointeur vers la structure de handle I2C
+ * @param data Pointeur vers une structure pour stocker les mesures
+ * @return Statut de l'opération (AHT20_ERROR_BUSY si la conversion n'est pas terminée)
+ */
+AHT20_Status AHT20_PollMeasurements(I2C_HandleTypeDef *hi2c, AHT20_Data *data) {
+    uint8_t status_byte;
+
+    if (hi2c == NULL || data == NULL) {
+        return AHT20_ERROR_INVALID_PARAM;
+    }
+    if (AHT20_GetStatus(hi2c, &status_byte) != AHT20_OK) {
+        return AHT20_ERROR_I2C;
+    }
+    if (status_byte & 0x80) { // Bit 7: Busy
         return AHT20_ERROR_BUSY;
     }
+    return AHT20_CollectMeasurements(hi2c, data);
+}
 
-    // Vérifier le checksum (sur les 6 premiers octets: Statut, H_data, T_data)
-    uint8_t calculated_crc = AHT20_CalculateChecksum(buffer, 6);
-    if (calculated_crc != buffer[6]) {
-        printf("Checksum invalide. Données reçues: ");
-        for (int i = 0; i < 7; i++) {
-            printf("0x%02X ", buffer[i]);
-        }
-        printf("\r\nChecksum attendu: 0x%02X, Calculé: 0x%02X\r\n", buffer[6], calculated_crc);
-        return AHT20_ERROR_CHECKSUM;
+/**
+ * @brief Lit les mesures de température et d'humidité
+ * @param hi2c Pointeur vers la structure de handle I2C
+ * @param data Pointeur vers une structure pour stocker les mesures
+ * @return Statut de l'opération
+ */
+AHT20_Status AHT20_ReadMeasurements(I2C_HandleTypeDef *hi2c, AHT20_Data *data) {
+    AHT20_Status status;
+
+    if (hi2c == NULL || data == NULL) {
+        return AHT20_ERROR_INVALID_PARAM;
     }
 
-    // Convertir les données
-    raw_humidity = ((buffer[1] << 12) | (buffer[2] << 4) | (buffer[3] >> 4));
-    raw_temperature = ((buffer[3] & 0x0F) << 16) | (buffer[4] << 8) | buffer[5];
+    // Envoyer la commande de mesure
+    status = AHT20_TriggerMeasurement(hi2c, NULL);
+    if (status != AHT20_OK) {
+        return status;
+    }
 
-    data->humidity = (raw_humidity * 100.0) / 1048576.0;
-    data->temperature = ((raw_temperature * 200.0) / 1048576.0) - 50.0;
+    // Attendre la fin de la mesure (datasheet: >=75ms, on utilise 80ms)
+    HAL_Delay(AHT20_DELAY_MEASUREMENT_WAIT_MS);
+
+    status = AHT20_CollectMeasurements(hi2c, data);
+    if (status == AHT20_ERROR_BUSY) {
+        printf("Capteur occupé après %d ms\r\n", AHT20_DELAY_MEASUREMENT_WAIT_MS);
+    }
+    return status;
+}
+
+/* --- Plusieurs capteurs derrière un multiplexeur I2C TCA9548A --- */
+
+/**
+ * @brief Initialise le descripteur du multiplexeur
+ * @param mux Pointeur vers le multiplexeur
+ * @param hi2c Bus du multiplexeur
+ * @param i2c_address_7bit Adresse 7 bits (0x70 à 0x77)
+ */
+void AHT20_Mux_Init(AHT20_Mux *mux, I2C_HandleTypeDef *hi2c, uint8_t i2c_address_7bit) {
+    mux->hi2c = hi2c;
+    mux->addr = (uint16_t)(i2c_address_7bit << 1);
+    mux->active = 0xFF; // Inconnu : le premier accès écrit le registre de contrôle
+}
 
+/**
+ * @brief Ouvre uniquement le canal du capteur (sauf s'il l'est déjà)
+ * @param h Pointeur vers le handle du capteur
+ * @return Statut de l'opération
+ */
+static AHT20_Status AHT20_Select(AHT20_Handle *h) {
+    uint8_t mask;
+
+    if (h->mux == NULL) {
+        return AHT20_OK;
+    }
+    mask = (uint8_t)(1u << h->channel);
+    if (h->mux->active == mask) {
+        return AHT20_OK; // Trame évitée
+    }
+    if (HAL_I2C_Master_Transmit(h->mux->hi2c, h->mux->addr, &mask, 1, AHT20_I2C_TIMEOUT_MS) != HAL_OK) {
+        h->mux->active = 0xFF;
+        return AHT20_ERROR_I2C;
+    }
+    h->mux->active = mask;
     return AHT20_OK;
 }
+
+/**
+ * @brief Associe un capteur à son bus et à son canal, puis l'initialise (bloquant, ~40 ms)
+ * @param h Pointeur vers le handle du capteur
+ * @param hi2c Bus I2C du capteur
+ * @param mux Multiplexeur (NULL si le capteur est relié directement)
+ * @param channel Canal 0..7 du multiplexeur, ou AHT20_NO_MUX_CHANNEL
+ * @return Statut de l'opération
+ */
+AHT20_Status AHT20_Handle_Init(AHT20_Handle *h, I2C_HandleTypeDef *hi2c, AHT20_Mux *mux, uint8_t channel) {
+    AHT20_Status status;
+
+    if (h == NULL || hi2c == NULL || (mux != NULL && channel > 7)) {
+        return AHT20_ERROR_INVALID_PARAM;
+    }
+    h->hi2c = hi2c;
+    h->mux = mux;
+    h->channel = channel;
+    h->measuring = 0;
+    h->ready_tick = 0;
+    h->data.temperature = 0.0f;
+    h->data.humidity = 0.0f;
+    h->status = AHT20_ERROR_BUSY; // Aucune mesure collectée
+
+    status = AHT20_Select(h);
+    if (status != AHT20_OK) {
+        return status;
+    }
+    return AHT20_Init(hi2c);
+}
+
+/**
+ * @brief Sélectionne le canal du capteur et déclenche une mesure
+ * @param h Pointeur vers le handle du capteur
+ * @return Statut de l'opération
+ */
+AHT20_Status AHT20_Handle_Trigger(AHT20_Handle *h) {
+    AHT20_Status status;
+
+    if (h == NULL) {
+        return AHT20_ERROR_INVALID_PARAM;
+    }
+    status = AHT20_Select(h);
+    if (status == AHT20_OK) {
+        status = AHT20_TriggerMeasurement(h->hi2c, &h->ready_tick);
+    }
+    h->measuring = (status == AHT20_OK);
+    return status;
+}
+
+/**
+ * @brief Sélectionne le canal du capteur et collecte la mesure déclenchée
+ * @param h Pointeur vers le handle du capteur
+ * @return Statut de l'opération (également mémorisé dans h->status)
+ */
+AHT20_Status AHT20_Handle_Collect(AHT20_Handle *h) {
+    AHT20_Status status;
+
+    if (h == NULL) {
+        return AHT20_ERROR_INVALID_PARAM;
+    }
+    status = AHT20_Select(h);
+    if (status == AHT20_OK) {
+        status = AHT20_CollectMeasurements(h->hi2c, &h->data);
+    }
+    if (status != AHT20_ERROR_BUSY) {
+        h->measuring = 0; // Une mesure encore en cours pourra être collectée plus tard
+    }
+    h->status = status;
+    return status;
+}
+
+/**
+ * @brief Déclenche tous les capteurs en une passe
+ * @param sensors Tableau de handles initialisés
+ * @param count Nombre de capteurs
+ * @return Nombre de capteurs déclenchés
+ */
+uint8_t AHT20_Batch_Trigger(AHT20_Handle *const sensors[], uint8_t count) {
+    uint8_t triggered = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (AHT20_Handle_Trigger(sensors[i]) == AHT20_OK) {
+            triggered++;
+        } else if (sensors[i] != NULL) {
+            sensors[i]->status = AHT20_ERROR_I2C;
+        }
+    }
+    return triggered;
+}
+
+/**
+ * @brief Collecte en une passe tous les capteurs déclenchés
+ * @param sensors Tableau de handles
+ * @param count Nombre de capteurs
+ * @return Nombre de mesures valides (h->status vaut AHT20_OK)
+ */
+uint8_t AHT20_Batch_Collect(AHT20_Handle *const sensors[], uint8_t count) {
+    uint8_t valid = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (sensors[i] != NULL && sensors[i]->measuring && AHT20_Handle_Collect(sensors[i]) == AHT20_OK) {
+            valid++;
+        }
+    }
+    return valid;
+}
+
+/**
+ * @brief Déclenche, attend une seule fois la mesure la plus tardive, puis collecte tous les capteurs
+ * @param sensors Tableau de handles initialisés
+ * @param count Nombre de capteurs
+ * @return Nombre de mesures valides
+ */
+uint8_t AHT20_Batch_Read(AHT20_Handle *const sensors[], uint8_t count) {
+    uint32_t last_ready = HAL_GetTick();
+
+    if (AHT20_Batch_Trigger(sensors, count) == 0) {
+        return 0;
+    }
+    // Le dernier capteur déclenché est le dernier prêt
+    for (uint8_t i = 0; i < count; i++) {
+        if (sensors[i] != NULL && sensors[i]->measuring && (int32_t)(sensors[i]->ready_tick - last_ready) > 0) {
+            last_ready = sensors[i]->ready_tick;
+        }
+    }
+    int32_t remaining = (int32_t)(last_ready - HAL_GetTick());
+    if (remaining > 0) {
+        HAL_Delay((uint32_t)remaining); // Une seule attente pour tous les capteurs
+    }
+    return AHT20_Batch_Collect(sensors, count);
+}
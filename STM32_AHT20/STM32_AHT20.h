@@ -56,4 +56,65 @@ AHT20_Status AHT20_ReadMeasurements(I2C_HandleTypeDef *hi2c, AHT20_Data *data);
 /* Fonction pour vérifier le statut du capteur */
 AHT20_Status AHT20_GetStatus(I2C_HandleTypeDef *hi2c, uint8_t *status);
 
+/* Mesure en deux temps (non bloquante) : plusieurs capteurs peuvent être déclenchés puis relevés en une passe */
+
+/* Déclenche une mesure et rend la main ; *ready_tick reçoit le HAL_GetTick() à partir duquel la collecter */
+AHT20_Status AHT20_TriggerMeasurement(I2C_HandleTypeDef *hi2c, uint32_t *ready_tick);
+
+/* Retourne 1 si ready_tick est atteint */
+uint8_t AHT20_IsReady(uint32_t ready_tick);
+
+/* Lit une mesure déclenchée (7 octets) ; AHT20_ERROR_BUSY si la conversion n'est pas terminée */
+AHT20_Status AHT20_CollectMeasurements(I2C_HandleTypeDef *hi2c, AHT20_Data *data);
+
+/* Lit d'abord l'octet de statut seul et ne collecte que si le bit busy est retombé (AHT20_ERROR_BUSY sinon) :
+   permet de récupérer la mesure dès qu'elle est prête, avant ready_tick */
+AHT20_Status AHT20_PollMeasurements(I2C_HandleTypeDef *hi2c, AHT20_Data *data);
+
+/* --- Plusieurs capteurs derrière un multiplexeur I2C TCA9548A --- */
+
+#define TCA9548A_I2C_ADDR_DEFAULT 0x70 // Adresse 7 bits par défaut (A2..A0 à 0), jusqu'à 0x77
+#define AHT20_NO_MUX_CHANNEL 0xFF      // Capteur relié directement au bus (pas de multiplexeur)
+
+/* Multiplexeur TCA9548A partagé par plusieurs handles ; le canal actif est mémorisé pour éviter les écritures inutiles */
+typedef struct
+{
+    I2C_HandleTypeDef *hi2c; // Bus du multiplexeur
+    uint16_t addr;           // Adresse 8 bits (décalée)
+    uint8_t active;          // Masque des canaux ouverts (0xFF tant qu'il est inconnu)
+} AHT20_Mux;
+
+/* Un capteur AHT20 : bus, canal du multiplexeur et état de la mesure en cours */
+typedef struct
+{
+    I2C_HandleTypeDef *hi2c; // Bus I2C
+    AHT20_Mux *mux;          // Multiplexeur (NULL si le capteur est relié directement)
+    uint8_t channel;         // Canal 0..7 du multiplexeur (ignoré sans multiplexeur)
+    uint8_t measuring;       // 1 entre le déclenchement et la collecte
+    uint32_t ready_tick;     // HAL_GetTick() à partir duquel la mesure est prête
+    AHT20_Data data;         // Dernière mesure collectée
+    AHT20_Status status;     // Résultat de la dernière collecte
+} AHT20_Handle;
+
+/* Initialise le multiplexeur (i2c_address_7bit : TCA9548A_I2C_ADDR_DEFAULT à 0x77) */
+void AHT20_Mux_Init(AHT20_Mux *mux, I2C_HandleTypeDef *hi2c, uint8_t i2c_address_7bit);
+
+/* Associe un capteur à son bus et à son canal (mux NULL et AHT20_NO_MUX_CHANNEL sans multiplexeur), puis l'initialise */
+AHT20_Status AHT20_Handle_Init(AHT20_Handle *h, I2C_HandleTypeDef *hi2c, AHT20_Mux *mux, uint8_t channel);
+
+/* Sélectionne le canal du capteur et déclenche une mesure (non bloquant) */
+AHT20_Status AHT20_Handle_Trigger(AHT20_Handle *h);
+
+/* Sélectionne le canal du capteur et collecte la mesure déclenchée dans h->data */
+AHT20_Status AHT20_Handle_Collect(AHT20_Handle *h);
+
+/* Première passe : déclenche tous les capteurs ; retourne le nombre de capteurs déclenchés */
+uint8_t AHT20_Batch_Trigger(AHT20_Handle *const sensors[], uint8_t count);
+
+/* Seconde passe : collecte tous les capteurs déclenchés (h->data, h->status) ; retourne le nombre de mesures valides */
+uint8_t AHT20_Batch_Collect(AHT20_Handle *const sensors[], uint8_t count);
+
+/* Déclenche tous les capteurs, attend une seule fois la fin des mesures (80 ms) puis les collecte */
+uint8_t AHT20_Batch_Read(AHT20_Handle *const sensors[], uint8_t count);
+
 #endif /* STM32_AHT20_H */
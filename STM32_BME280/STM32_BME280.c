@@ -6,6 +6,7 @@
  */
 
 #include "STM32_BME280.h"
+#include "STM32_CRC8.h" // CRC8 partagé (dossier STM32_CRC8), contrôle du blob de calibration
 
 #ifdef DEBUG_ON
     #include <stdio.h> // Inclure stdio.h pour utiliser printf
@@ -80,18 +81,13 @@ static HAL_StatusTypeDef BME280_ReadBytes(BME280_Handle_t *dev, uint8_t reg, uin
 }
 
 /**
- * @brief Lit les coefficients de calibration du BME280.
+ * @brief Décode les coefficients de calibration à partir des registres bruts.
  * @param dev Pointeur vers la structure de gestion du périphérique BME280.
- * @retval Statut HAL.
+ * @param raw Registres 0x88 à 0xA1 (26 octets) suivis de 0xE1 à 0xE7 (7 octets).
  */
-static HAL_StatusTypeDef BME280_ReadCoefficients(BME280_Handle_t *dev) {
-    uint8_t buffer[26]; // Tampon pour lire T1-P9 (26 octets)
-    uint8_t h_buffer[8]; // Tampon pour H1-H6 (8 octets au total, non contigus)
-    HAL_StatusTypeDef status;
-
-    // Lire T1-P9 (registres 0x88 à 0x9F + 0xA1)
-    status = BME280_ReadBytes(dev, BME280_REGISTER_DIG_T1, buffer, 24); // T1-P9 sont contigus (0x88 à 0x9F)
-    if (status != HAL_OK) return status;
+static void BME280_ParseCoefficients(BME280_Handle_t *dev, const uint8_t *raw) {
+    const uint8_t *buffer = raw;                      // T1-P9 (0x88 à 0x9F), 0xA0 réservé, H1 (0xA1)
+    const uint8_t *h_buffer = raw + BME280_CALIB_TP_SIZE; // H2-H6 (0xE1 à 0xE7)
 
     // Extraction des coefficients de calibration pour la température et la pression
     dev->calib_data.dig_T1 = (uint16_t)(((uint16_t)buffer[1] << 8) | buffer[0]);
@@ -106,14 +102,7 @@ static HAL_StatusTypeDef BME280_ReadCoefficients(BME280_Handle_t *dev) {
     dev->calib_data.dig_P7 = (int16_t)(((int16_t)buffer[19] << 8) | buffer[18]);
     dev->calib_data.dig_P8 = (int16_t)(((int16_t)buffer[21] << 8) | buffer[20]);
     dev->calib_data.dig_P9 = (int16_t)(((int16_t)buffer[23] << 8) | buffer[22]);
-
-    // Lire H1 (0xA1)
-    status = BME280_ReadByte(dev, BME280_REGISTER_DIG_H1, &dev->calib_data.dig_H1);
-    if (status != HAL_OK) return status;
-
-    // Lire H2-H6 (registres 0xE1 à 0xE7)
-    status = BME280_ReadBytes(dev, BME280_REGISTER_DIG_H2, h_buffer, 7); // Lire 7 octets de 0xE1 à 0xE7
-    if (status != HAL_OK) return status;
+    dev->calib_data.dig_H1 = buffer[25];
 
     // Extraction des coefficients de calibration pour l'humidité
     dev->calib_data.dig_H2 = (int16_t)(((int16_t)h_buffer[1] << 8) | h_buffer[0]); // H2 (0xE1, 0xE2)
@@ -121,8 +110,23 @@ static HAL_StatusTypeDef BME280_ReadCoefficients(BME280_Handle_t *dev) {
     dev->calib_data.dig_H4 = (int16_t)(((int16_t)h_buffer[3] << 4) | (h_buffer[4] & 0x0F)); // H4 (0xE4, 0xE5[3:0])
     dev->calib_data.dig_H5 = (int16_t)(((int16_t)h_buffer[5] << 4) | (h_buffer[4] >> 4));   // H5 (0xE6, 0xE5[7:4])
     dev->calib_data.dig_H6 = (int8_t)h_buffer[6];                                          // H6 (0xE7)
+}
 
-    return HAL_OK;
+/**
+ * @brief Lit les registres de calibration bruts en deux lectures groupées (minimum possible, blocs non contigus).
+ * @param dev Pointeur vers la structure de gestion du périphérique BME280.
+ * @param raw Tampon de BME280_CALIB_RAW_SIZE octets.
+ * @retval Statut HAL.
+ */
+static HAL_StatusTypeDef BME280_ReadCoefficients(BME280_Handle_t *dev, uint8_t *raw) {
+    HAL_StatusTypeDef status;
+
+    // T1-P9 + H1 (registres 0x88 à 0xA1, 0xA0 inclus mais ignoré)
+    status = BME280_ReadBytes(dev, BME280_REGISTER_DIG_T1, raw, BME280_CALIB_TP_SIZE);
+    if (status != HAL_OK) return status;
+
+    // H2-H6 (registres 0xE1 à 0xE7)
+    return BME280_ReadBytes(dev, BME280_REGISTER_DIG_H2, raw + BME280_CALIB_TP_SIZE, BME280_CALIB_H_SIZE);
 }
 
 // --- Vérification de l'état I2C ---
@@ -133,6 +137,104 @@ static HAL_StatusTypeDef BME280_CheckI2CStatus(HAL_StatusTypeDef status) {
     return status;
 }
 
+/**
+ * @brief Écrit ctrl_hum, config puis ctrl_meas à partir de dev->config.
+ * @param dev Pointeur vers la structure de gestion du périphérique BME280.
+ * @retval Statut HAL.
+ */
+static HAL_StatusTypeDef BME280_WriteConfig(BME280_Handle_t *dev) {
+    HAL_StatusTypeDef status;
+
+    // 1. Configuration de l'humidité (doit être écrit avant ctrl_meas)
+    uint8_t ctrl_hum = dev->config.oversampling_h & 0x07;
+    status = BME280_WriteByte(dev, BME280_REGISTER_CONTROLHUMID, ctrl_hum);
+    if (status != HAL_OK) {
+        DEBUG_PRINT("Erreur lors de l'écriture dans BME280_REGISTER_CONTROLHUMID.\r\n");
+        return status;
+    }
+
+    // 2. Configuration du filtre et du temps d'attente
+    uint8_t config_reg = ((dev->config.standby_time & 0x07) << 5) | ((dev->config.filter & 0x07) << 2);
+    status = BME280_WriteByte(dev, BME280_REGISTER_CONFIG, config_reg);
+    if (status != HAL_OK) {
+        DEBUG_PRINT("Erreur lors de l'écriture dans BME280_REGISTER_CONFIG.\r\n");
+        return status;
+    }
+
+    // 3. Configuration du suréchantillonnage T/P et du mode
+    // Note: Le mode est écrit en dernier. Si on écrit FORCED, une mesure démarre.
+    uint8_t ctrl_meas = ((dev->config.oversampling_t & 0x07) << 5) | ((dev->config.oversampling_p & 0x07) << 2) | (dev->config.mode & 0x03);
+    status = BME280_WriteByte(dev, BME280_REGISTER_CONTROL, ctrl_meas);
+    if (status != HAL_OK) {
+        DEBUG_PRINT("Erreur lors de l'écriture dans BME280_REGISTER_CONTROL.\r\n");
+    }
+    return status;
+}
+
+// --- Compensation (formules entières du datasheet Bosch) ---
+
+/**
+ * @brief Extrait les valeurs ADC brutes d'une trame de 8 octets lue à partir de 0xF7.
+ */
+static void BME280_ParseRaw(const uint8_t *buffer, int32_t *adc_P, int32_t *adc_T, int32_t *adc_H) {
+    *adc_P = (int32_t)(((uint32_t)buffer[0] << 12) | ((uint32_t)buffer[1] << 4) | ((uint32_t)buffer[2] >> 4));
+    *adc_T = (int32_t)(((uint32_t)buffer[3] << 12) | ((uint32_t)buffer[4] << 4) | ((uint32_t)buffer[5] >> 4));
+    *adc_H = (int32_t)(((uint32_t)buffer[6] << 8) | (uint32_t)buffer[7]);
+}
+
+/**
+ * @brief Compense la température et met à jour t_fine.
+ * @retval Température en centièmes de °C.
+ */
+static int32_t BME280_CompensateTemperature(BME280_Handle_t *dev, int32_t adc_T) {
+    int32_t var1 = (int32_t)((adc_T / 8) - ((int32_t)dev->calib_data.dig_T1 * 2));
+    var1 = (var1 * ((int32_t)dev->calib_data.dig_T2)) / 2048;
+    int32_t var2 = (int32_t)((adc_T / 16) - ((int32_t)dev->calib_data.dig_T1));
+    var2 = (((var2 * var2) / 4096) * ((int32_t)dev->calib_data.dig_T3)) / 16384;
+    dev->t_fine = var1 + var2;
+    return (dev->t_fine * 5 + 128) / 256;
+}
+
+/**
+ * @brief Compense la pression (t_fine doit être à jour).
+ * @retval Pression en Pa au format Q24.8 (0 si le calcul est impossible).
+ */
+static uint32_t BME280_CompensatePressure(const BME280_Handle_t *dev, int32_t adc_P) {
+    int64_t var1 = ((int64_t)dev->t_fine) - 128000;
+    int64_t var2 = var1 * var1 * (int64_t)dev->calib_data.dig_P6;
+    var2 = var2 + ((var1 * (int64_t)dev->calib_data.dig_P5) << 17);
+    var2 = var2 + (((int64_t)dev->calib_data.dig_P4) << 35);
+    var1 = ((var1 * var1 * (int64_t)dev->calib_data.dig_P3) >> 8) + ((var1 * (int64_t)dev->calib_data.dig_P2) << 12);
+    var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)dev->calib_data.dig_P1) >> 33;
+
+    if (var1 == 0) {
+        return 0; // Éviter la division par zéro
+    }
+
+    int64_t p_acc = 1048576 - adc_P;
+    p_acc = (((p_acc << 31) - var2) * 3125) / var1;
+    var1 = (((int64_t)dev->calib_data.dig_P9) * (p_acc >> 13) * (p_acc >> 13)) >> 25;
+    var2 = (((int64_t)dev->calib_data.dig_P8) * p_acc) >> 19;
+    p_acc = ((p_acc + var1 + var2) >> 8) + (((int64_t)dev->calib_data.dig_P7) << 4);
+    return (uint32_t)p_acc;
+}
+
+/**
+ * @brief Compense l'humidité (t_fine doit être à jour).
+ * @retval Humidité en %RH au format Q22.10.
+ */
+static uint32_t BME280_CompensateHumidity(const BME280_Handle_t *dev, int32_t adc_H) {
+    int32_t v_x1_u32r = (dev->t_fine - ((int32_t)76800));
+    v_x1_u32r = (((((adc_H << 14) - (((int32_t)dev->calib_data.dig_H4) << 20) - (((int32_t)dev->calib_data.dig_H5) * v_x1_u32r)) +
+                  ((int32_t)16384)) >> 15) * (((((((v_x1_u32r * ((int32_t)dev->calib_data.dig_H6)) >> 10) * (((v_x1_u32r *
+                  ((int32_t)dev->calib_data.dig_H3)) >> 11) + ((int32_t)32768))) >> 10) + ((int32_t)2097152)) *
+                  ((int32_t)dev->calib_data.dig_H2) + 8192) >> 14));
+    v_x1_u32r = (v_x1_u32r - (((((v_x1_u32r >> 15) * (v_x1_u32r >> 15)) >> 7) * ((int32_t)dev->calib_data.dig_H1)) >> 4));
+    v_x1_u32r = (v_x1_u32r < 0 ? 0 : v_x1_u32r);
+    v_x1_u32r = (v_x1_u32r > 419430400 ? 419430400 : v_x1_u32r); // Max 100% RH * 2^22
+    return (uint32_t)(v_x1_u32r >> 12);
+}
+
 // --- Fonctions API publiques ---
 
 /**
@@ -145,9 +247,25 @@ static HAL_StatusTypeDef BME280_CheckI2CStatus(HAL_StatusTypeDef status) {
  * @retval BME280_OK si succès, sinon un code d'erreur BME280_ERROR_xxx.
  */
 int8_t BME280_Init(BME280_Handle_t *dev, I2C_HandleTypeDef *hi2c, uint8_t dev_addr, BME280_Config_t *config) {
+    return BME280_InitWithStorage(dev, hi2c, dev_addr, config, NULL);
+}
+
+/**
+ * @brief Initialise le capteur en chargeant la calibration depuis un cache si possible.
+ * @param storage Callbacks de stockage de la calibration, ou NULL.
+ * @retval BME280_OK si succès, sinon un code d'erreur BME280_ERROR_xxx.
+ */
+int8_t BME280_InitWithStorage(BME280_Handle_t *dev, I2C_HandleTypeDef *hi2c, uint8_t dev_addr, BME280_Config_t *config,
+                              const BME280_CalibStorage_t *storage) {
+    if (dev == NULL || hi2c == NULL) {
+        return BME280_ERROR_PARAM;
+    }
     dev->hi2c = hi2c;
     dev->dev_addr = dev_addr;
     dev->t_fine = 0;
+    dev->async_state = BME280_ASYNC_IDLE;
+    dev->async_cb = NULL;
+    dev->async_ctx = NULL;
 
     uint8_t chip_id; // Variable pour stocker l'identifiant de la puce
     HAL_StatusTypeDef status; // Variable pour stocker le statut des opérations HAL
@@ -185,10 +303,29 @@ int8_t BME280_Init(BME280_Handle_t *dev, I2C_HandleTypeDef *hi2c, uint8_t dev_ad
         return BME280_ERROR_CHIP_ID;
     }
 
-    // Lire les coefficients de calibration
-    status = BME280_ReadCoefficients(dev);
-    if (status != HAL_OK) {
-        return BME280_ERROR_COMM;
+    // Charger la calibration depuis le cache, sinon la lire sur le capteur
+    uint8_t blob[BME280_CALIB_BLOB_SIZE];
+    uint8_t cached = 0;
+    if (storage != NULL && storage->load != NULL &&
+        storage->load(chip_id, dev->dev_addr, blob, BME280_CALIB_BLOB_SIZE, storage->ctx) == 0 &&
+        blob[0] == chip_id && CRC8_Poly31(blob, BME280_CALIB_BLOB_SIZE - 1, 0xFF) == blob[BME280_CALIB_BLOB_SIZE - 1]) {
+        cached = 1;
+        DEBUG_PRINT("Calibration chargée depuis le cache.\r\n");
+    } else {
+        status = BME280_ReadCoefficients(dev, &blob[1]);
+        if (status != HAL_OK) {
+            return BME280_ERROR_COMM;
+        }
+        blob[0] = chip_id;
+        blob[BME280_CALIB_BLOB_SIZE - 1] = CRC8_Poly31(blob, BME280_CALIB_BLOB_SIZE - 1, 0xFF);
+    }
+    BME280_ParseCoefficients(dev, &blob[1]);
+
+    // Mémoriser la calibration pour les prochains démarrages (un échec n'empêche pas l'initialisation)
+    if (!cached && storage != NULL && storage->store != NULL) {
+        if (storage->store(chip_id, dev->dev_addr, blob, BME280_CALIB_BLOB_SIZE, storage->ctx) != 0) {
+            DEBUG_PRINT("Impossible d'enregistrer la calibration dans le cache.\r\n");
+        }
     }
 
     // Réinitialiser le capteur
@@ -199,28 +336,8 @@ int8_t BME280_Init(BME280_Handle_t *dev, I2C_HandleTypeDef *hi2c, uint8_t dev_ad
     HAL_Delay(10); // Attendre que le reset soit effectif
 
     // Écrire la configuration
-    // 1. Configuration de l'humidité (doit être écrit avant ctrl_meas)
-    uint8_t ctrl_hum = dev->config.oversampling_h & 0x07;
-    status = BME280_WriteByte(dev, BME280_REGISTER_CONTROLHUMID, ctrl_hum);
-    if (status != HAL_OK) {
-        DEBUG_PRINT("Erreur lors de l'écriture dans BME280_REGISTER_CONTROLHUMID.\r\n");
-        return BME280_ERROR_CONFIG;
-    }
-
-    // 2. Configuration du filtre et du temps d'attente
-    uint8_t config_reg = ((dev->config.standby_time & 0x07) << 5) | ((dev->config.filter & 0x07) << 2);
-    status = BME280_WriteByte(dev, BME280_REGISTER_CONFIG, config_reg);
-     if (status != HAL_OK) {
-        DEBUG_PRINT("Erreur lors de l'écriture dans BME280_REGISTER_CONFIG.\r\n");
-        return BME280_ERROR_CONFIG;
-    }
-
-    // 3. Configuration du suréchantillonnage T/P et du mode
-    // Note: Le mode est écrit en dernier. Si on écrit FORCED, une mesure démarre.
-    uint8_t ctrl_meas = ((dev->config.oversampling_t & 0x07) << 5) | ((dev->config.oversampling_p & 0x07) << 2) | (dev->config.mode & 0x03);
-    status = BME280_WriteByte(dev, BME280_REGISTER_CONTROL, ctrl_meas);
+    status = BME280_WriteConfig(dev);
     if (status != HAL_OK) {
-        DEBUG_PRINT("Erreur lors de l'écriture dans BME280_REGISTER_CONTROL.\r\n");
         return BME280_ERROR_CONFIG;
     }
 
@@ -263,13 +380,7 @@ HAL_StatusTypeDef BME280_ReadTemperature(BME280_Handle_t *dev, float *temperatur
 
     int32_t adc_T = (int32_t)(((uint32_t)buffer[0] << 12) | ((uint32_t)buffer[1] << 4) | ((uint32_t)buffer[2] >> 4));
 
-    // Formule de compensation du datasheet
-    int32_t var1 = (int32_t)((adc_T / 8) - ((int32_t)dev->calib_data.dig_T1 * 2));
-    var1 = (var1 * ((int32_t)dev->calib_data.dig_T2)) / 2048;
-    int32_t var2 = (int32_t)((adc_T / 16) - ((int32_t)dev->calib_data.dig_T1));
-    var2 = (((var2 * var2) / 4096) * ((int32_t)dev->calib_data.dig_T3)) / 16384;
-    dev->t_fine = var1 + var2;
-    *temperature = (float)((dev->t_fine * 5 + 128) / 256) / 100.0f;
+    *temperature = (float)BME280_CompensateTemperature(dev, adc_T) / 100.0f;
 
     return HAL_OK;
 }
@@ -288,27 +399,7 @@ HAL_StatusTypeDef BME280_ReadPressure(BME280_Handle_t *dev, float *pressure) {
         if (status != HAL_OK) return status;
     }
 
-    // Formule de compensation du datasheet
-    int64_t var1 = ((int64_t)dev->t_fine) - 128000;
-    int64_t var2 = var1 * var1 * (int64_t)dev->calib_data.dig_P6;
-    var2 = var2 + ((var1 * (int64_t)dev->calib_data.dig_P5) << 17); // * 131072
-    var2 = var2 + (((int64_t)dev->calib_data.dig_P4) << 35); // * 34359738368
-    var1 = ((var1 * var1 * (int64_t)dev->calib_data.dig_P3) >> 8) + ((var1 * (int64_t)dev->calib_data.dig_P2) << 12); // * 4096
-    var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)dev->calib_data.dig_P1) >> 33; // * 140737488355328 / 8589934592
-
-    if (var1 == 0) {
-        *pressure = 0; // Éviter la division par zéro
-        return HAL_OK;
-    }
-
-    int64_t p_acc = 1048576 - adc_P;
-    p_acc = (((p_acc << 31) - var2) * 3125) / var1;
-    var1 = (((int64_t)dev->calib_data.dig_P9) * (p_acc >> 13) * (p_acc >> 13)) >> 25; // / 33554432
-    var2 = (((int64_t)dev->calib_data.dig_P8) * p_acc) >> 19; // / 524288
-
-    p_acc = ((p_acc + var1 + var2) >> 8) + (((int64_t)dev->calib_data.dig_P7) << 4); // * 16
-
-    *pressure = (float)p_acc / 256.0f; // Pression en Pa
+    *pressure = (float)BME280_CompensatePressure(dev, adc_P) / 256.0f; // Pression en Pa (0 si calcul impossible)
 
     return HAL_OK;
 }
@@ -332,39 +423,33 @@ HAL_StatusTypeDef BME280_ReadHumidity(BME280_Handle_t *dev, float *humidity) {
         if (status != HAL_OK) return status;
     }
 
-    // Formule de compensation du datasheet
-    int32_t v_x1_u32r = (dev->t_fine - ((int32_t)76800));
-    v_x1_u32r = (((((adc_H << 14) - (((int32_t)dev->calib_data.dig_H4) << 20) - (((int32_t)dev->calib_data.dig_H5) * v_x1_u32r)) +
-                  ((int32_t)16384)) >> 15) * (((((((v_x1_u32r * ((int32_t)dev->calib_data.dig_H6)) >> 10) * (((v_x1_u32r *
-                  ((int32_t)dev->calib_data.dig_H3)) >> 11) + ((int32_t)32768))) >> 10) + ((int32_t)2097152)) *
-                  ((int32_t)dev->calib_data.dig_H2) + 8192) >> 14));
-    v_x1_u32r = (v_x1_u32r - (((((v_x1_u32r >> 15) * (v_x1_u32r >> 15)) >> 7) * ((int32_t)dev->calib_data.dig_H1)) >> 4));
-    v_x1_u32r = (v_x1_u32r < 0 ? 0 : v_x1_u32r);
-    v_x1_u32r = (v_x1_u32r > 419430400 ? 419430400 : v_x1_u32r); // Max 100% RH * 2^22
-
-    *humidity = (float)(v_x1_u32r >> 12) / 1024.0f; // Humidité en %RH
+    *humidity = (float)BME280_CompensateHumidity(dev, adc_H) / 1024.0f; // Humidité en %RH
 
     return HAL_OK;
 }
 
 /**
- * @brief Lit toutes les données (température, pression, humidité) du capteur.
- * @param dev Pointeur vers la structure de gestion du périphérique BME280.
- * @param temperature Pointeur pour stocker la température lue.
- * @param pressure Pointeur pour stocker la pression lue.
- * @param humidity Pointeur pour stocker l'humidité lue.
- * @retval Statut HAL.
- * @retval BME280_OK si la lecture réussit, sinon un code d'erreur BME280_ERROR_xxx.
+ * @brief Compense une trame brute de 8 octets (sortie entière, met à jour t_fine).
  */
-int8_t BME280_ReadAll(BME280_Handle_t *dev, float *temperature, float *pressure, float *humidity) {
-    if (dev == NULL || temperature == NULL || pressure == NULL || humidity == NULL) {
-        DEBUG_PRINT("Paramètre invalide fourni à BME280_ReadAll.\r\n");
+static void BME280_CompensateFrame(BME280_Handle_t *dev, const uint8_t *frame, BME280_IntData_t *data) {
+    int32_t adc_P, adc_T, adc_H;
+    BME280_ParseRaw(frame, &adc_P, &adc_T, &adc_H);
+
+    // La température doit être compensée en premier pour t_fine
+    data->temperature = BME280_CompensateTemperature(dev, adc_T);
+    data->pressure = BME280_CompensatePressure(dev, adc_P);
+    data->humidity = (adc_H == 0x8000) ? BME280_HUMIDITY_INVALID : BME280_CompensateHumidity(dev, adc_H);
+}
+
+/**
+ * @brief Lit la trame brute 0xF7..0xFE (mesure forcée déclenchée si besoin).
+ */
+int8_t BME280_ReadRaw(BME280_Handle_t *dev, uint8_t *frame) {
+    if (dev == NULL || frame == NULL) {
+        DEBUG_PRINT("Paramètre invalide fourni à BME280_ReadRaw.\r\n");
         return BME280_ERROR_PARAM;
     }
 
-    HAL_StatusTypeDef status;
-    uint8_t buffer[8]; // Buffer pour lire Pression(3), Température(3), Humidité(2)
-
     // Si en mode FORCED, déclencher une mesure et attendre
     if (dev->config.mode == BME280_MODE_FORCED) {
         int8_t forced_status = BME280_TriggerForcedMeasurement(dev, 100); // Timeout de 100ms
@@ -374,61 +459,68 @@ int8_t BME280_ReadAll(BME280_Handle_t *dev, float *temperature, float *pressure,
     }
 
     // Lecture groupée des données de 0xF7 à 0xFE (8 octets)
-    status = BME280_ReadBytes(dev, BME280_REGISTER_PRESSUREDATA, buffer, 8);
-    if (status != HAL_OK) {
+    if (BME280_ReadBytes(dev, BME280_REGISTER_PRESSUREDATA, frame, BME280_RAW_FRAME_SIZE) != HAL_OK) {
         DEBUG_PRINT("Erreur lors de la lecture groupée des données.\r\n");
         return BME280_ERROR_COMM;
     }
+    return BME280_OK;
+}
 
-    // Extraire les données brutes ADC
-    int32_t adc_P = (int32_t)(((uint32_t)buffer[0] << 12) | ((uint32_t)buffer[1] << 4) | ((uint32_t)buffer[2] >> 4));
-    int32_t adc_T = (int32_t)(((uint32_t)buffer[3] << 12) | ((uint32_t)buffer[4] << 4) | ((uint32_t)buffer[5] >> 4));
-    int32_t adc_H = (int32_t)(((uint32_t)buffer[6] << 8) | (uint32_t)buffer[7]);
-
-    // --- Compensation Température (doit être faite en premier pour t_fine) ---
-    int32_t var1_T = (int32_t)((adc_T / 8) - ((int32_t)dev->calib_data.dig_T1 * 2));
-    var1_T = (var1_T * ((int32_t)dev->calib_data.dig_T2)) / 2048;
-    int32_t var2_T = (int32_t)((adc_T / 16) - ((int32_t)dev->calib_data.dig_T1));
-    var2_T = (((var2_T * var2_T) / 4096) * ((int32_t)dev->calib_data.dig_T3)) / 16384;
-    dev->t_fine = var1_T + var2_T;
-    *temperature = (float)((dev->t_fine * 5 + 128) / 256) / 100.0f;
-
-    // --- Compensation Pression ---
-    int64_t var1_P = ((int64_t)dev->t_fine) - 128000;
-    int64_t var2_P = var1_P * var1_P * (int64_t)dev->calib_data.dig_P6;
-    var2_P = var2_P + ((var1_P * (int64_t)dev->calib_data.dig_P5) << 17);
-    var2_P = var2_P + (((int64_t)dev->calib_data.dig_P4) << 35);
-    var1_P = ((var1_P * var1_P * (int64_t)dev->calib_data.dig_P3) >> 8) + ((var1_P * (int64_t)dev->calib_data.dig_P2) << 12);
-    var1_P = (((((int64_t)1) << 47) + var1_P)) * ((int64_t)dev->calib_data.dig_P1) >> 33;
-
-    if (var1_P == 0) {
-        *pressure = 0; // Éviter la division par zéro
-    } else {
-        int64_t p_acc = 1048576 - adc_P;
-        p_acc = (((p_acc << 31) - var2_P) * 3125) / var1_P;
-        var1_P = (((int64_t)dev->calib_data.dig_P9) * (p_acc >> 13) * (p_acc >> 13)) >> 25;
-        var2_P = (((int64_t)dev->calib_data.dig_P8) * p_acc) >> 19;
-        p_acc = ((p_acc + var1_P + var2_P) >> 8) + (((int64_t)dev->calib_data.dig_P7) << 4);
-        *pressure = (float)p_acc / 256.0f; // Pression en Pa
-    }
-
-    // --- Compensation Humidité ---
-    if (adc_H == 0x8000) { // Mesure ignorée ou invalide
-         *humidity = 0.0f / 0.0f; // NaN
-         // On pourrait retourner une erreur ici, mais on a déjà lu T et P
-         // return BME280_ERROR; // Ou un code spécifique
-    } else {
-        int32_t v_x1_u32r = (dev->t_fine - ((int32_t)76800));
-        v_x1_u32r = (((((adc_H << 14) - (((int32_t)dev->calib_data.dig_H4) << 20) - (((int32_t)dev->calib_data.dig_H5) * v_x1_u32r)) +
-                      ((int32_t)16384)) >> 15) * (((((((v_x1_u32r * ((int32_t)dev->calib_data.dig_H6)) >> 10) * (((v_x1_u32r *
-                      ((int32_t)dev->calib_data.dig_H3)) >> 11) + ((int32_t)32768))) >> 10) + ((int32_t)2097152)) *
-                      ((int32_t)dev->calib_data.dig_H2) + 8192) >> 14));
-        v_x1_u32r = (v_x1_u32r - (((((v_x1_u32r >> 15) * (v_x1_u32r >> 15)) >> 7) * ((int32_t)dev->calib_data.dig_H1)) >> 4));
-        v_x1_u32r = (v_x1_u32r < 0 ? 0 : v_x1_u32r);
-        v_x1_u32r = (v_x1_u32r > 419430400 ? 419430400 : v_x1_u32r); // Max 100% RH * 2^22
-        *humidity = (float)(v_x1_u32r >> 12) / 1024.0f; // Humidité en %RH
+/**
+ * @brief Lit et compense toutes les données en virgule fixe.
+ */
+int8_t BME280_ReadAllInt(BME280_Handle_t *dev, BME280_IntData_t *data) {
+    if (dev == NULL || data == NULL) {
+        return BME280_ERROR_PARAM;
     }
 
+    uint8_t frame[BME280_RAW_FRAME_SIZE];
+    int8_t status = BME280_ReadRaw(dev, frame);
+    if (status != BME280_OK) {
+        return status;
+    }
+    BME280_CompensateFrame(dev, frame, data);
+    return BME280_OK;
+}
+
+/**
+ * @brief Compense un tableau de trames brutes en une seule passe.
+ */
+int8_t BME280_CompensateBatch(BME280_Handle_t *dev, const uint8_t *frames, BME280_IntData_t *data, uint16_t count) {
+    if (dev == NULL || (count != 0 && (frames == NULL || data == NULL))) {
+        return BME280_ERROR_PARAM;
+    }
+    for (uint16_t i = 0; i < count; i++) {
+        BME280_CompensateFrame(dev, frames, &data[i]);
+        frames += BME280_RAW_FRAME_SIZE;
+    }
+    return BME280_OK;
+}
+
+/**
+ * @brief Lit toutes les données (température, pression, humidité) du capteur.
+ * @param dev Pointeur vers la structure de gestion du périphérique BME280.
+ * @param temperature Pointeur pour stocker la température lue.
+ * @param pressure Pointeur pour stocker la pression lue.
+ * @param humidity Pointeur pour stocker l'humidité lue.
+ * @retval BME280_OK si la lecture réussit, sinon un code d'erreur BME280_ERROR_xxx.
+ */
+int8_t BME280_ReadAll(BME280_Handle_t *dev, float *temperature, float *pressure, float *humidity) {
+    if (dev == NULL || temperature == NULL || pressure == NULL || humidity == NULL) {
+        DEBUG_PRINT("Paramètre invalide fourni à BME280_ReadAll.\r\n");
+        return BME280_ERROR_PARAM;
+    }
+
+    BME280_IntData_t data;
+    int8_t status = BME280_ReadAllInt(dev, &data);
+    if (status != BME280_OK) {
+        return status;
+    }
+
+    *temperature = (float)data.temperature / 100.0f;
+    *pressure = (float)data.pressure / 256.0f; // Pression en Pa
+    *humidity = (data.humidity == BME280_HUMIDITY_INVALID) ? 0.0f / 0.0f : (float)data.humidity / 1024.0f; // NaN si ignorée
+
     return BME280_OK;
 }
 
@@ -469,3 +561,290 @@ int8_t BME280_TriggerForcedMeasurement(BME280_Handle_t *dev, uint32_t timeout) {
         HAL_Delay(1); // Petite pause pour ne pas saturer le bus I2C
     } while (1);
 }
+
+// --- Temps de mesure ---
+
+// Facteur de suréchantillonnage (nombre de conversions) pour chaque valeur de BME280_Oversampling_t
+static const uint8_t bme280_osrs_factor[6] = {0, 1, 2, 4, 8, 16};
+
+// Temps d'attente t_standby en µs pour chaque valeur de BME280_StandbyTime_t
+static const uint32_t bme280_standby_us[8] = {500, 62500, 125000, 250000, 500000, 1000000, 10000, 20000};
+
+/**
+ * @brief Temps de mesure maximal (datasheet §9.1) en µs.
+ */
+uint32_t BME280_GetMeasurementTime_us(const BME280_Config_t *config) {
+    if (config == NULL) return 0;
+    uint8_t osrs_t = (config->oversampling_t <= BME280_OVERSAMPLING_X16) ? bme280_osrs_factor[config->oversampling_t] : 16;
+    uint8_t osrs_p = (config->oversampling_p <= BME280_OVERSAMPLING_X16) ? bme280_osrs_factor[config->oversampling_p] : 16;
+    uint8_t osrs_h = (config->oversampling_h <= BME280_OVERSAMPLING_X16) ? bme280_osrs_factor[config->oversampling_h] : 16;
+
+    // t_meas,max = 1.25 + 2.3*osrs_t + [2.3*osrs_p + 0.575] + [2.3*osrs_h + 0.575] ms
+    uint32_t t_us = 1250 + 2300 * (uint32_t)osrs_t;
+    if (osrs_p != 0) t_us += 2300 * (uint32_t)osrs_p + 575;
+    if (osrs_h != 0) t_us += 2300 * (uint32_t)osrs_h + 575;
+    return t_us;
+}
+
+/**
+ * @brief Période d'un cycle en mode normal (t_meas + t_standby) en µs.
+ */
+uint32_t BME280_GetNormalPeriod_us(const BME280_Config_t *config) {
+    if (config == NULL) return 0;
+    return BME280_GetMeasurementTime_us(config) + bme280_standby_us[config->standby_time & 0x07];
+}
+
+// --- Mesure forcée asynchrone ---
+
+/**
+ * @brief Vrai si une mesure est en cours ou si un callback attend encore son résultat.
+ *        Dans ces cas, toucher à async_cb/async_ctx orphelinerait la mesure en vol.
+ */
+static uint8_t BME280_AsyncBusy(const BME280_Handle_t *dev) {
+    if (dev->async_state == BME280_ASYNC_CONVERTING || dev->async_state == BME280_ASYNC_READING) {
+        return 1;
+    }
+    // DONE avec callback : BME280_AsyncProcess n'a pas encore pu lancer la lecture en interruption
+    return dev->async_state == BME280_ASYNC_DONE && dev->async_cb != NULL;
+}
+
+/**
+ * @brief Déclenche la conversion et mémorise l'échéance (commun aux deux variantes).
+ */
+static int8_t BME280_AsyncTrigger(BME280_Handle_t *dev) {
+    if (dev->async_state == BME280_ASYNC_CONVERTING || dev->async_state == BME280_ASYNC_READING) {
+        return BME280_ERROR_MEASURING;
+    }
+
+    // ctrl_meas est reconstruit depuis la configuration : pas de lecture-modification-écriture
+    uint8_t ctrl_meas = ((dev->config.oversampling_t & 0x07) << 5) | ((dev->config.oversampling_p & 0x07) << 2) | BME280_MODE_FORCED;
+    if (BME280_WriteByte(dev, BME280_REGISTER_CONTROL, ctrl_meas) != HAL_OK) {
+        dev->async_state = BME280_ASYNC_IDLE;
+        return BME280_ERROR_COMM;
+    }
+    dev->config.mode = BME280_MODE_FORCED;
+
+    // +1 ms car HAL_GetTick() peut s'incrémenter juste après le déclenchement
+    dev->async_wait_ms = (BME280_GetMeasurementTime_us(&dev->config) + 999) / 1000 + 1;
+    dev->async_start = HAL_GetTick();
+    dev->async_state = BME280_ASYNC_CONVERTING;
+    return BME280_OK;
+}
+
+/**
+ * @brief Passe en état DONE si la durée de conversion est écoulée.
+ */
+static uint8_t BME280_AsyncElapsed(BME280_Handle_t *dev) {
+    if (dev->async_state == BME280_ASYNC_CONVERTING && (HAL_GetTick() - dev->async_start) >= dev->async_wait_ms) {
+        dev->async_state = BME280_ASYNC_DONE;
+    }
+    return dev->async_state == BME280_ASYNC_DONE;
+}
+
+/**
+ * @brief Déclenche une mesure forcée sans attendre.
+ */
+int8_t BME280_StartForced(BME280_Handle_t *dev) {
+    if (dev == NULL) return BME280_ERROR_PARAM;
+    if (BME280_AsyncBusy(dev)) return BME280_ERROR_MEASURING;
+    dev->async_cb = NULL;
+    dev->async_ctx = NULL;
+    return BME280_AsyncTrigger(dev);
+}
+
+/**
+ * @brief Vérifie si la conversion est terminée (sans accès I2C).
+ */
+int8_t BME280_PollForced(BME280_Handle_t *dev) {
+    if (dev == NULL || dev->async_state == BME280_ASYNC_IDLE) return BME280_ERROR_PARAM;
+    return BME280_AsyncElapsed(dev) ? BME280_OK : BME280_ERROR_MEASURING;
+}
+
+/**
+ * @brief Lit et compense le résultat d'une mesure forcée terminée.
+ */
+int8_t BME280_CompleteForced(BME280_Handle_t *dev, BME280_IntData_t *data) {
+    if (dev == NULL || data == NULL || dev->async_state == BME280_ASYNC_IDLE) return BME280_ERROR_PARAM;
+    if (!BME280_AsyncElapsed(dev)) return BME280_ERROR_MEASURING;
+
+    uint8_t frame[BME280_RAW_FRAME_SIZE];
+    dev->async_state = BME280_ASYNC_IDLE;
+    if (BME280_ReadBytes(dev, BME280_REGISTER_PRESSUREDATA, frame, BME280_RAW_FRAME_SIZE) != HAL_OK) {
+        return BME280_ERROR_COMM;
+    }
+    BME280_CompensateFrame(dev, frame, data);
+    return BME280_OK;
+}
+
+/**
+ * @brief Déclenche une mesure forcée livrée par callback.
+ */
+int8_t BME280_StartForcedCallback(BME280_Handle_t *dev, BME280_AsyncCallback_t cb, void *ctx) {
+    if (dev == NULL || cb == NULL) return BME280_ERROR_PARAM;
+    if (BME280_AsyncBusy(dev)) return BME280_ERROR_MEASURING;
+    dev->async_cb = cb;
+    dev->async_ctx = ctx;
+    return BME280_AsyncTrigger(dev);
+}
+
+/**
+ * @brief Lance la lecture en interruption quand la conversion est terminée.
+ */
+void BME280_AsyncProcess(BME280_Handle_t *dev) {
+    if (dev == NULL || dev->async_cb == NULL || !BME280_AsyncElapsed(dev)) return;
+
+    dev->async_state = BME280_ASYNC_READING;
+    if (HAL_I2C_Mem_Read_IT(dev->hi2c, (dev->dev_addr << 1), BME280_REGISTER_PRESSUREDATA, I2C_MEMADD_SIZE_8BIT,
+                            dev->async_frame, BME280_RAW_FRAME_SIZE) != HAL_OK) {
+        dev->async_state = BME280_ASYNC_DONE; // Bus occupé : nouvel essai au prochain tick
+    }
+}
+
+/**
+ * @brief Fin de la lecture en interruption : compensation et appel du callback.
+ */
+void BME280_AsyncRxCpltCallback(BME280_Handle_t *dev, uint8_t error) {
+    if (dev == NULL || dev->async_state != BME280_ASYNC_READING) return;
+
+    BME280_IntData_t data = {0};
+    int8_t status = BME280_ERROR_COMM;
+    dev->async_state = BME280_ASYNC_IDLE;
+    if (!error) {
+        BME280_CompensateFrame(dev, dev->async_frame, &data);
+        status = BME280_OK;
+    }
+    if (dev->async_cb != NULL) {
+        dev->async_cb(dev, &data, status, dev->async_ctx);
+    }
+}
+
+// --- Streaming en mode normal ---
+
+/**
+ * @brief Passe le capteur en mode normal et initialise le tampon de streaming.
+ */
+int8_t BME280_StreamStart(BME280_Stream_t *stream, BME280_Handle_t *dev) {
+    if (stream == NULL || dev == NULL) {
+        return BME280_ERROR_PARAM;
+    }
+
+    stream->dev = dev;
+    stream->head = 0;
+    stream->tail = 0;
+    stream->dropped = 0;
+    stream->active = 0;
+
+    dev->config.mode = BME280_MODE_NORMAL;
+    if (BME280_WriteConfig(dev) != HAL_OK) {
+        return BME280_ERROR_CONFIG;
+    }
+
+    stream->period_us = BME280_GetNormalPeriod_us(&dev->config);
+    // Le premier résultat est disponible t_meas après l'écriture de ctrl_meas
+    stream->next_us = HAL_GetTick() * 1000u + BME280_GetMeasurementTime_us(&dev->config);
+    stream->active = 1;
+
+    DEBUG_PRINT("Streaming BME280 démarré (période %lu us).\r\n", (unsigned long)stream->period_us);
+    return BME280_OK;
+}
+
+/**
+ * @brief Arrête le streaming et remet le capteur en veille.
+ */
+int8_t BME280_StreamStop(BME280_Stream_t *stream) {
+    if (stream == NULL || stream->dev == NULL) {
+        return BME280_ERROR_PARAM;
+    }
+    stream->active = 0;
+    if (BME280_SetMode(stream->dev, BME280_MODE_SLEEP) != HAL_OK) {
+        return BME280_ERROR_COMM;
+    }
+    return BME280_OK;
+}
+
+/**
+ * @brief Lit une trame par période écoulée et l'ajoute au tampon circulaire.
+ */
+int8_t BME280_StreamTick(BME280_Stream_t *stream) {
+    if (stream == NULL || stream->dev == NULL || !stream->active) {
+        return BME280_ERROR_PARAM;
+    }
+
+    uint32_t now_us = HAL_GetTick() * 1000u;
+    if ((int32_t)(now_us - stream->next_us) < 0) {
+        return BME280_OK; // Pas encore de nouvelle mesure
+    }
+
+    BME280_Handle_t *dev = stream->dev;
+
+    // Lecture groupée STATUS (0xF3) .. HUM_LSB (0xFE) : l'état et la trame arrivent dans la même transaction
+    uint8_t frame[BME280_STREAM_FRAME_SIZE];
+    if (BME280_ReadBytes(dev, BME280_REGISTER_STATUS, frame, BME280_STREAM_FRAME_SIZE) != HAL_OK) {
+        return BME280_ERROR_COMM;
+    }
+
+    // Copie NVM en cours : relire 1 ms plus tard. Le bit 'measuring' n'est pas un motif de rejet :
+    // en mode normal les registres de données sont doublés (shadowing), une lecture pendant la
+    // conversion renvoie le dernier échantillon complet.
+    if (frame[0] & BME280_STATUS_IM_UPDATE) {
+        stream->next_us = now_us + 1000u;
+        return BME280_OK;
+    }
+    const uint8_t *buffer = &frame[BME280_REGISTER_PRESSUREDATA - BME280_REGISTER_STATUS];
+
+    // Échéance suivante à la période nominale ; si le retard dépasse une période, on repart de maintenant
+    stream->next_us += stream->period_us;
+    if ((int32_t)(now_us - stream->next_us) >= 0) {
+        stream->next_us = now_us + stream->period_us;
+    }
+
+    uint16_t head = stream->head;
+    uint16_t next = (uint16_t)((head + 1) & (BME280_STREAM_BUFFER_SIZE - 1));
+    if (next == stream->tail) {
+        stream->dropped++; // Tampon plein : l'échantillon le plus récent est perdu
+        return BME280_OK;
+    }
+
+    int32_t adc_P, adc_T, adc_H;
+    BME280_ParseRaw(buffer, &adc_P, &adc_T, &adc_H);
+
+    BME280_Sample_t *sample = &stream->buffer[head];
+    sample->temperature = (float)BME280_CompensateTemperature(dev, adc_T) / 100.0f;
+    sample->pressure = (float)BME280_CompensatePressure(dev, adc_P) / 256.0f;
+    sample->humidity = (adc_H == 0x8000) ? 0.0f / 0.0f : (float)BME280_CompensateHumidity(dev, adc_H) / 1024.0f;
+    sample->timestamp = HAL_GetTick();
+
+    stream->head = next; // Publication après écriture complète de l'échantillon
+    return BME280_OK;
+}
+
+/**
+ * @brief Nombre d'échantillons disponibles dans le tampon.
+ */
+uint16_t BME280_StreamAvailable(const BME280_Stream_t *stream) {
+    if (stream == NULL) return 0;
+    return (uint16_t)((stream->head - stream->tail) & (BME280_STREAM_BUFFER_SIZE - 1));
+}
+
+/**
+ * @brief Retire l'échantillon le plus ancien du tampon.
+ */
+int8_t BME280_StreamRead(BME280_Stream_t *stream, BME280_Sample_t *sample) {
+    if (stream == NULL || sample == NULL) {
+        return BME280_ERROR_PARAM;
+    }
+    uint16_t tail = stream->tail;
+    if (tail == stream->head) {
+        return BME280_ERROR_MEASURING; // Aucun échantillon disponible
+    }
+    *sample = stream->buffer[tail];
+    stream->tail = (uint16_t)((tail + 1) & (BME280_STREAM_BUFFER_SIZE - 1));
+    return BME280_OK;
+}
+
+/**
+ * @brief Nombre d'échantillons perdus car le tampon était plein.
+ */
+uint32_t BME280_StreamGetDropped(const BME280_Stream_t *stream) {
+    return (stream == NULL) ? 0 : stream->dropped;
+}
@@ -52,6 +52,8 @@
 #define BME280_REGISTER_SOFTRESET 0xE0    // Registre pour réinitialiser le capteur
 #define BME280_REGISTER_CONTROLHUMID 0xF2 // Contrôle du suréchantillonnage de l'humidité
 #define BME280_REGISTER_STATUS 0xF3       // Statut du capteur
+#define BME280_STATUS_MEASURING 0x08      // Bit 'measuring' : conversion en cours
+#define BME280_STATUS_IM_UPDATE 0x01      // Bit 'im_update' : copie NVM en cours
 #define BME280_REGISTER_CONTROL 0xF4      // Contrôle du mode et du suréchantillonnage
 #define BME280_REGISTER_CONFIG 0xF5       // Configuration (filtrage, temps d'attente)
 #define BME280_REGISTER_PRESSUREDATA 0xF7 // Données de pression
@@ -145,18 +147,111 @@ typedef struct
     BME280_StandbyTime_t standby_time;    // Temps d'attente en mode Normal
 } BME280_Config_t;
 
+// --- Calibration ---
+#define BME280_CALIB_TP_SIZE 26   // Registres 0x88 à 0xA1 (T1-P9, réservé, H1)
+#define BME280_CALIB_H_SIZE 7     // Registres 0xE1 à 0xE7 (H2-H6)
+#define BME280_CALIB_RAW_SIZE (BME280_CALIB_TP_SIZE + BME280_CALIB_H_SIZE)
+#define BME280_CALIB_BLOB_SIZE (BME280_CALIB_RAW_SIZE + 2) // ID de puce + registres bruts + CRC8 (STM32_CRC8)
+
 /**
- * @brief Structure principale pour gérer le capteur BME280.
+ * @brief Callbacks de sauvegarde de la calibration du BME280 entre deux démarrages.
+ *        Le blob (BME280_CALIB_BLOB_SIZE octets) contient l'ID de puce, les 33 registres bruts
+ *        0x88-0xA1 et 0xE1-0xE7, puis un CRC8. Le couple (chip_id, dev_addr) permet de ranger
+ *        séparément deux BME280 (0x76 et 0x77) sur le même bus. Un blob dont l'ID ou le CRC
+ *        ne correspond pas est ignoré : la calibration est alors relue sur le capteur.
  */
 typedef struct
+{
+    // Charge le blob associé à (chip_id, dev_addr) dans blob (len octets). Retourne 0 si trouvé.
+    int8_t (*load)(uint8_t chip_id, uint8_t dev_addr, uint8_t *blob, uint16_t len, void *ctx);
+    // Enregistre le blob associé à (chip_id, dev_addr). Retourne 0 si succès. Peut être NULL.
+    int8_t (*store)(uint8_t chip_id, uint8_t dev_addr, const uint8_t *blob, uint16_t len, void *ctx);
+    void *ctx; // Pointeur utilisateur transmis aux callbacks
+} BME280_CalibStorage_t;
+
+#define BME280_RAW_FRAME_SIZE 8                 // Octets lus de 0xF7 à 0xFE (pression, température, humidité)
+#define BME280_HUMIDITY_INVALID 0xFFFFFFFFUL     // Humidité non mesurée (suréchantillonnage H ignoré)
+
+/**
+ * @brief Résultats compensés en virgule fixe (formules entières Bosch, sans flottant).
+ *        Conversion : T = temperature / 100 °C, P = pressure / 256 Pa, H = humidity / 1024 %RH.
+ */
+typedef struct
+{
+    int32_t temperature; // Température en centièmes de °C (2508 = 25.08 °C)
+    uint32_t pressure;   // Pression en Pa, format Q24.8 (25939200 = 101325.0 Pa)
+    uint32_t humidity;   // Humidité en %RH, format Q22.10 (47445 = 46.333 %RH), BME280_HUMIDITY_INVALID si ignorée
+} BME280_IntData_t;
+
+// États de la mesure forcée asynchrone
+typedef enum
+{
+    BME280_ASYNC_IDLE = 0,       // Aucune mesure en cours
+    BME280_ASYNC_CONVERTING = 1, // Conversion en cours dans le capteur
+    BME280_ASYNC_READING = 2,    // Lecture I2C en interruption en cours (variante callback)
+    BME280_ASYNC_DONE = 3        // Conversion terminée, données prêtes à être lues
+} BME280_AsyncState_t;
+
+struct BME280_Handle_s;
+
+/**
+ * @brief Callback appelé à la fin d'une mesure forcée asynchrone.
+ * @param dev Capteur ayant terminé sa mesure.
+ * @param data Résultats compensés (valides uniquement si status == BME280_OK).
+ * @param status BME280_OK ou BME280_ERROR_COMM.
+ * @param ctx Pointeur utilisateur fourni à BME280_StartForcedCallback.
+ */
+typedef void (*BME280_AsyncCallback_t)(struct BME280_Handle_s *dev, const BME280_IntData_t *data, int8_t status, void *ctx);
+
+/**
+ * @brief Structure principale pour gérer le capteur BME280.
+ */
+typedef struct BME280_Handle_s
 {
     I2C_HandleTypeDef *hi2c;       // Pointeur vers la structure de gestion I2C (HAL)
     uint8_t dev_addr;              // Adresse I2C 7 bits du capteur (non décalée)
     BME280_Config_t config;        // Configuration actuelle du capteur
     BME280_CalibData_t calib_data; // Données de calibration lues depuis le capteur
     int32_t t_fine;                // Valeur fine de température utilisée pour la compensation
+
+    // Mesure forcée asynchrone
+    volatile BME280_AsyncState_t async_state;   // État courant de la mesure
+    uint32_t async_start;                       // HAL_GetTick() au déclenchement
+    uint32_t async_wait_ms;                     // Durée de conversion attendue (arrondie au ms supérieur + 1)
+    uint8_t async_frame[BME280_RAW_FRAME_SIZE]; // Trame reçue par la variante callback
+    BME280_AsyncCallback_t async_cb;            // Callback de fin (NULL pour la variante start/poll/complete)
+    void *async_ctx;                            // Pointeur utilisateur transmis au callback
 } BME280_Handle_t;
 
+/**
+ * @brief Échantillon compensé produit par le streaming en mode normal.
+ */
+typedef struct
+{
+    float temperature;  // Température en °C
+    float pressure;     // Pression en Pa
+    float humidity;     // Humidité en %RH (NaN si humidité désactivée)
+    uint32_t timestamp; // HAL_GetTick() au moment de la lecture
+} BME280_Sample_t;
+
+#define BME280_STREAM_BUFFER_SIZE 16 // Taille du tampon circulaire (puissance de 2, SIZE-1 échantillons utiles)
+#define BME280_STREAM_FRAME_SIZE 12  // Lecture groupée STATUS (0xF3) à HUM_LSB (0xFE)
+
+/**
+ * @brief Contexte de streaming en mode normal (tampon circulaire sans verrou, 1 producteur / 1 consommateur).
+ */
+typedef struct
+{
+    BME280_Handle_t *dev;                               // Capteur associé
+    BME280_Sample_t buffer[BME280_STREAM_BUFFER_SIZE];  // Échantillons compensés
+    volatile uint16_t head;                             // Index d'écriture (producteur : BME280_StreamTick)
+    volatile uint16_t tail;                             // Index de lecture (consommateur : BME280_StreamRead)
+    volatile uint32_t dropped;                          // Échantillons perdus (tampon plein)
+    uint32_t period_us;                                 // Période d'un cycle t_meas + t_standby en µs
+    uint32_t next_us;                                   // Échéance de la prochaine lecture (HAL_GetTick() * 1000)
+    volatile uint8_t active;                            // 1 si le streaming est en cours
+} BME280_Stream_t;
+
 // --- Prototypes des fonctions ---
 
 // --- Documentation améliorée ---
@@ -170,6 +265,21 @@ typedef struct
  */
 int8_t BME280_Init(BME280_Handle_t *dev, I2C_HandleTypeDef *hi2c, uint8_t dev_addr, BME280_Config_t *config);
 
+/**
+ * @brief Initialise le capteur BME280 en utilisant un cache de calibration.
+ *        Si storage->load fournit un blob valide pour l'ID de puce lu, aucune lecture de
+ *        calibration n'est faite sur le bus ; sinon la calibration est lue (2 lectures groupées)
+ *        puis transmise à storage->store.
+ * @param dev Pointeur vers la structure de gestion du capteur.
+ * @param hi2c Pointeur vers la structure de gestion I2C.
+ * @param dev_addr Adresse I2C 7 bits du capteur.
+ * @param config Pointeur vers la configuration souhaitée, ou NULL pour la configuration par défaut.
+ * @param storage Callbacks de stockage de la calibration, ou NULL (équivalent à BME280_Init).
+ * @retval BME280_OK si l'initialisation réussit, sinon un code d'erreur BME280_ERROR_xxx.
+ */
+int8_t BME280_InitWithStorage(BME280_Handle_t *dev, I2C_HandleTypeDef *hi2c, uint8_t dev_addr, BME280_Config_t *config,
+                              const BME280_CalibStorage_t *storage);
+
 /**
  * @brief Lit la température depuis le capteur.
  * @param dev Pointeur vers la structure de gestion du capteur.
@@ -204,6 +314,35 @@ HAL_StatusTypeDef BME280_ReadHumidity(BME280_Handle_t *dev, float *humidity);
  */
 int8_t BME280_ReadAll(BME280_Handle_t *dev, float *temperature, float *pressure, float *humidity);
 
+/**
+ * @brief Lit la trame brute de 8 octets (0xF7 à 0xFE) sans compensation.
+ *        En mode FORCED, une mesure est déclenchée et attendue au préalable.
+ *        Permet de stocker les trames et de les compenser plus tard avec BME280_CompensateBatch.
+ * @param dev Pointeur vers la structure de gestion du capteur.
+ * @param frame Tampon d'au moins BME280_RAW_FRAME_SIZE octets.
+ * @retval BME280_OK si la lecture réussit, sinon un code d'erreur BME280_ERROR_xxx.
+ */
+int8_t BME280_ReadRaw(BME280_Handle_t *dev, uint8_t *frame);
+
+/**
+ * @brief Lit toutes les données et les retourne en virgule fixe (aucun calcul flottant).
+ * @param dev Pointeur vers la structure de gestion du capteur.
+ * @param data Pointeur pour stocker les résultats (centi-°C, Pa Q24.8, %RH Q22.10).
+ * @retval BME280_OK si la lecture réussit, sinon un code d'erreur BME280_ERROR_xxx.
+ */
+int8_t BME280_ReadAllInt(BME280_Handle_t *dev, BME280_IntData_t *data);
+
+/**
+ * @brief Compense en une passe un tableau de trames brutes lues par BME280_ReadRaw.
+ *        Aucun accès I2C : seules les données de calibration de dev sont utilisées.
+ * @param dev Pointeur vers la structure de gestion du capteur (calibration chargée).
+ * @param frames Trames concaténées (count * BME280_RAW_FRAME_SIZE octets).
+ * @param data Tableau de count résultats.
+ * @param count Nombre de trames.
+ * @retval BME280_OK, ou BME280_ERROR_PARAM si un pointeur est NULL.
+ */
+int8_t BME280_CompensateBatch(BME280_Handle_t *dev, const uint8_t *frames, BME280_IntData_t *data, uint16_t count);
+
 /**
  * @brief Définit le mode de fonctionnement du capteur.
  * @param dev Pointeur vers la structure de gestion du capteur.
@@ -235,4 +374,131 @@ HAL_StatusTypeDef BME280_Reset(BME280_Handle_t *dev);
  */
 int8_t BME280_TriggerForcedMeasurement(BME280_Handle_t *dev, uint32_t timeout);
 
+// --- Mesure forcée asynchrone ---
+
+/**
+ * @brief Déclenche une mesure forcée sans attendre (une seule écriture de ctrl_meas).
+ *        La durée de conversion est calculée à partir du suréchantillonnage configuré ;
+ *        aucun accès au bus n'a lieu avant qu'elle soit écoulée. Plusieurs capteurs
+ *        peuvent convertir en même temps, chacun avec son propre handle.
+ * @param dev Pointeur vers la structure de gestion du capteur.
+ * @retval BME280_OK si la mesure est lancée, BME280_ERROR_MEASURING si une mesure est déjà en cours
+ *         (y compris une mesure BME280_StartForcedCallback dont le callback n'a pas encore été appelé),
+ *         BME280_ERROR_COMM en cas d'erreur I2C.
+ */
+int8_t BME280_StartForced(BME280_Handle_t *dev);
+
+/**
+ * @brief Vérifie, sans accès I2C, si la conversion lancée par BME280_StartForced est terminée.
+ * @param dev Pointeur vers la structure de gestion du capteur.
+ * @retval BME280_OK si les données sont prêtes, BME280_ERROR_MEASURING si la conversion est en cours,
+ *         BME280_ERROR_PARAM si aucune mesure n'a été lancée.
+ */
+int8_t BME280_PollForced(BME280_Handle_t *dev);
+
+/**
+ * @brief Lit et compense le résultat d'une mesure forcée terminée (une lecture groupée de 8 octets).
+ * @param dev Pointeur vers la structure de gestion du capteur.
+ * @param data Pointeur pour stocker les résultats en virgule fixe.
+ * @retval BME280_OK si succès, BME280_ERROR_MEASURING si la conversion n'est pas terminée,
+ *         sinon un code d'erreur BME280_ERROR_xxx.
+ */
+int8_t BME280_CompleteForced(BME280_Handle_t *dev, BME280_IntData_t *data);
+
+/**
+ * @brief Variante callback : déclenche une mesure forcée ; le résultat est livré à cb
+ *        par BME280_AsyncProcess / BME280_AsyncRxCpltCallback.
+ * @param dev Pointeur vers la structure de gestion du capteur.
+ * @param cb Callback de fin de mesure (ne doit pas être NULL).
+ * @param ctx Pointeur utilisateur transmis au callback.
+ * @retval Comme BME280_StartForced, ou BME280_ERROR_PARAM si cb est NULL.
+ */
+int8_t BME280_StartForcedCallback(BME280_Handle_t *dev, BME280_AsyncCallback_t cb, void *ctx);
+
+/**
+ * @brief A appeler depuis un tick timer (ou la boucle principale) pour chaque capteur en variante callback.
+ *        Lorsque la conversion est terminée, lance la lecture des 8 octets par HAL_I2C_Mem_Read_IT.
+ *        Si le bus est occupé (autre capteur en cours de lecture), la lecture est retentée au tick suivant.
+ * @param dev Pointeur vers la structure de gestion du capteur.
+ */
+void BME280_AsyncProcess(BME280_Handle_t *dev);
+
+/**
+ * @brief A appeler depuis HAL_I2C_MemRxCpltCallback (et HAL_I2C_ErrorCallback avec error = 1)
+ *        pour le capteur dont le bus a terminé. Compense la trame et appelle le callback utilisateur.
+ * @param dev Pointeur vers la structure de gestion du capteur.
+ * @param error 0 si le transfert a réussi, 1 en cas d'erreur I2C.
+ */
+void BME280_AsyncRxCpltCallback(BME280_Handle_t *dev, uint8_t error);
+
+// --- Streaming en mode normal ---
+
+/**
+ * @brief Calcule le temps de mesure maximal d'un cycle à partir du suréchantillonnage (datasheet §9.1).
+ *        t_meas = 1.25 + 2.3*osrs_t + (2.3*osrs_p + 0.575) + (2.3*osrs_h + 0.575) ms,
+ *        les termes pression/humidité étant omis si la mesure est ignorée.
+ * @param config Pointeur vers la configuration.
+ * @retval Temps de mesure en µs (0 si config est NULL).
+ */
+uint32_t BME280_GetMeasurementTime_us(const BME280_Config_t *config);
+
+/**
+ * @brief Calcule la période exacte d'un cycle en mode normal (t_meas + t_standby).
+ * @param config Pointeur vers la configuration.
+ * @retval Période en µs (0 si config est NULL).
+ */
+uint32_t BME280_GetNormalPeriod_us(const BME280_Config_t *config);
+
+/**
+ * @brief Passe le capteur en mode normal avec sa configuration courante et prépare le streaming.
+ * @param stream Pointeur vers le contexte de streaming.
+ * @param dev Pointeur vers la structure de gestion du capteur (déjà initialisé).
+ * @retval BME280_OK si succès, sinon un code d'erreur BME280_ERROR_xxx.
+ */
+int8_t BME280_StreamStart(BME280_Stream_t *stream, BME280_Handle_t *dev);
+
+/**
+ * @brief Arrête le streaming et remet le capteur en mode veille.
+ * @param stream Pointeur vers le contexte de streaming.
+ * @retval BME280_OK si succès, sinon un code d'erreur BME280_ERROR_xxx.
+ */
+int8_t BME280_StreamStop(BME280_Stream_t *stream);
+
+/**
+ * @brief A appeler périodiquement (tick d'un timer, ou boucle principale sur drapeau du timer).
+ *        Ne touche le bus qu'une fois par période de mesure : une seule lecture groupée de 12 octets
+ *        (STATUS puis données), compensation puis ajout au tampon. Les échéances suivent la période
+ *        nominale t_meas + t_standby. Les registres de données étant doublés en mode normal, une
+ *        lecture pendant une conversion (bit measuring) renvoie le dernier échantillon complet et est
+ *        acceptée ; seule une copie NVM en cours (bit im_update) fait relire la trame 1 ms plus tard.
+ *        Une trame identique à la précédente (entrée stable, filtre IIR) est un échantillon valide.
+ *        Le tick doit être plus rapide que la période (1 ms conseillé).
+ * @param stream Pointeur vers le contexte de streaming.
+ * @retval BME280_OK (échantillon ajouté ou rien à faire), BME280_ERROR_COMM en cas d'erreur I2C,
+ *         BME280_ERROR_PARAM si le streaming n'est pas actif.
+ */
+int8_t BME280_StreamTick(BME280_Stream_t *stream);
+
+/**
+ * @brief Retourne le nombre d'échantillons disponibles dans le tampon.
+ * @param stream Pointeur vers le contexte de streaming.
+ * @retval Nombre d'échantillons en attente.
+ */
+uint16_t BME280_StreamAvailable(const BME280_Stream_t *stream);
+
+/**
+ * @brief Retire l'échantillon le plus ancien du tampon.
+ * @param stream Pointeur vers le contexte de streaming.
+ * @param sample Pointeur pour stocker l'échantillon.
+ * @retval BME280_OK si un échantillon a été lu, BME280_ERROR_MEASURING si le tampon est vide.
+ */
+int8_t BME280_StreamRead(BME280_Stream_t *stream, BME280_Sample_t *sample);
+
+/**
+ * @brief Retourne le nombre d'échantillons perdus parce que le tampon était plein.
+ * @param stream Pointeur vers le contexte de streaming.
+ * @retval Nombre d'échantillons perdus.
+ */
+uint32_t BME280_StreamGetDropped(const BME280_Stream_t *stream);
+
 #endif /* INC_STM32_BME280_H_ */
@@ -1,24 +1,26 @@
 #include "STM32_BME680.h"
+#include <string.h>
 
-// Handler I2C
-static I2C_HandleTypeDef *s_bme680_i2c_handle = NULL;
-
-// Fonctions de communication I2C
-static int8_t stm32_bme680_i2c_read(uint8_t dev_id, uint8_t reg_addr, uint8_t *data, uint16_t len)
+// Fonctions de communication I2C (intf_ptr : handle I2C propre à chaque capteur)
+static int8_t stm32_bme680_i2c_read(uint8_t dev_id, uint8_t reg_addr, uint8_t *data, uint16_t len, void *intf_ptr)
 {
-    if (s_bme680_i2c_handle == NULL)
+    I2C_HandleTypeDef *hi2c = (I2C_HandleTypeDef *)intf_ptr;
+
+    if (hi2c == NULL)
         return BME680_E_NULL_PTR;
-    if (HAL_I2C_Mem_Read(s_bme680_i2c_handle, (uint16_t)(dev_id << 1), reg_addr, I2C_MEMADD_SIZE_8BIT, data, len, HAL_MAX_DELAY) == HAL_OK)
+    if (HAL_I2C_Mem_Read(hi2c, (uint16_t)(dev_id << 1), reg_addr, I2C_MEMADD_SIZE_8BIT, data, len, HAL_MAX_DELAY) == HAL_OK)
     {
         return BME680_OK;
     }
     return BME680_E_COM_FAIL;
 }
-static int8_t stm32_bme680_i2c_write(uint8_t dev_id, uint8_t reg_addr, uint8_t *data, uint16_t len)
+static int8_t stm32_bme680_i2c_write(uint8_t dev_id, uint8_t reg_addr, uint8_t *data, uint16_t len, void *intf_ptr)
 {
-    if (s_bme680_i2c_handle == NULL)
+    I2C_HandleTypeDef *hi2c = (I2C_HandleTypeDef *)intf_ptr;
+
+    if (hi2c == NULL)
         return BME680_E_NULL_PTR;
-    if (HAL_I2C_Mem_Write(s_bme680_i2c_handle, (uint16_t)(dev_id << 1), reg_addr, I2C_MEMADD_SIZE_8BIT, data, len, HAL_MAX_DELAY) == HAL_OK)
+    if (HAL_I2C_Mem_Write(hi2c, (uint16_t)(dev_id << 1), reg_addr, I2C_MEMADD_SIZE_8BIT, data, len, HAL_MAX_DELAY) == HAL_OK)
     {
         return BME680_OK;
     }
@@ -235,15 +237,39 @@ static uint8_t calc_heater_dur(uint16_t dur)
 }
 
 // Fonctions liées à la configuration
-static int8_t read_field_data(struct bme680_field_data *data, struct bme680_dev *dev)
+static void parse_field_data(const uint8_t *buff, struct bme680_field_data *data, struct bme680_dev *dev)
 {
-    int8_t status;
-    uint8_t buff[BME680_FIELD_LENGTH] = {0};
     uint8_t gas_range;
     uint32_t adc_temp;
     uint32_t adc_pres;
     uint16_t adc_hum;
     uint16_t adc_gas_res;
+
+    data->status = buff[0] & BME680_NEW_DATA_MSK;
+    data->gas_index = buff[0] & BME680_GAS_INDEX_MSK;
+    data->meas_index = buff[1];
+
+    adc_pres = (uint32_t)(((uint32_t)buff[2] * 4096) | ((uint32_t)buff[3] * 16) | ((uint32_t)buff[4] / 16));
+    adc_temp = (uint32_t)(((uint32_t)buff[5] * 4096) | ((uint32_t)buff[6] * 16) | ((uint32_t)buff[7] / 16));
+    adc_hum = (uint16_t)(((uint32_t)buff[8] * 256) | (uint32_t)buff[9]);
+    adc_gas_res = (uint16_t)((uint32_t)buff[13] * 4 | (((uint32_t)buff[14]) / 64));
+    gas_range = buff[14] & BME680_GAS_RANGE_MSK;
+
+    data->status |= buff[14] & BME680_GASM_VALID_MSK;
+    data->status |= buff[14] & BME680_HEAT_STAB_MSK;
+
+    if (data->status & BME680_NEW_DATA_MSK)
+    {
+        data->temperature = calc_temperature(adc_temp, dev);
+        data->pressure = calc_pressure(adc_pres, dev);
+        data->humidity = calc_humidity(adc_hum, dev);
+        data->gas_resistance = calc_gas_resistance(adc_gas_res, gas_range, dev);
+    }
+}
+static int8_t read_field_data(struct bme680_field_data *data, struct bme680_dev *dev)
+{
+    int8_t status;
+    uint8_t buff[BME680_FIELD_LENGTH] = {0};
     uint8_t tries = 10;
 
     status = null_ptr_check(dev);
@@ -254,25 +280,9 @@ static int8_t read_field_data(struct bme680_field_data *data, struct bme680_dev
             status = bme680_get_regs(((uint8_t)(BME680_FIELD0_ADDR)), buff, (uint16_t)BME680_FIELD_LENGTH,
                                      dev);
 
-            data->status = buff[0] & BME680_NEW_DATA_MSK;
-            data->gas_index = buff[0] & BME680_GAS_INDEX_MSK;
-            data->meas_index = buff[1];
-
-            adc_pres = (uint32_t)(((uint32_t)buff[2] * 4096) | ((uint32_t)buff[3] * 16) | ((uint32_t)buff[4] / 16));
-            adc_temp = (uint32_t)(((uint32_t)buff[5] * 4096) | ((uint32_t)buff[6] * 16) | ((uint32_t)buff[7] / 16));
-            adc_hum = (uint16_t)(((uint32_t)buff[8] * 256) | (uint32_t)buff[9]);
-            adc_gas_res = (uint16_t)((uint32_t)buff[13] * 4 | (((uint32_t)buff[14]) / 64));
-            gas_range = buff[14] & BME680_GAS_RANGE_MSK;
-
-            data->status |= buff[14] & BME680_GASM_VALID_MSK;
-            data->status |= buff[14] & BME680_HEAT_STAB_MSK;
-
+            parse_field_data(buff, data, dev);
             if (data->status & BME680_NEW_DATA_MSK)
             {
-                data->temperature = calc_temperature(adc_temp, dev);
-                data->pressure = calc_pressure(adc_pres, dev);
-                data->humidity = calc_humidity(adc_hum, dev);
-                data->gas_resistance = calc_gas_resistance(adc_gas_res, gas_range, dev);
                 break;
             }
             dev->delay_ms(BME680_POLL_PERIOD_MS);
@@ -289,7 +299,7 @@ static int8_t get_calib_data(struct bme680_dev *dev)
 {
     int8_t status;
     uint8_t coeff_array[BME680_COEFF_SIZE] = {0};
-    uint8_t temp_var = 0;
+    uint8_t heat_regs[BME680_ADDR_RANGE_SW_ERR_ADDR + 1] = {0};
 
     status = null_ptr_check(dev);
     if (status == BME680_OK)
@@ -334,21 +344,13 @@ static int8_t get_calib_data(struct bme680_dev *dev)
                                                            coeff_array[BME680_GH2_LSB_REG]));
         dev->calib.par_gh3 = (int8_t)coeff_array[BME680_GH3_REG];
 
+        /* res_heat_val (0x00), res_heat_range (0x02) et range_sw_err (0x04) en une seule lecture */
         if (status == BME680_OK)
-        {
-            status = bme680_get_regs(BME680_ADDR_RES_HEAT_RANGE_ADDR, &temp_var, 1, dev);
+            status = bme680_get_regs(BME680_ADDR_RES_HEAT_VAL_ADDR, heat_regs, sizeof(heat_regs), dev);
 
-            dev->calib.res_heat_range = ((temp_var & BME680_RHRANGE_MSK) / 16);
-            if (status == BME680_OK)
-            {
-                status = bme680_get_regs(BME680_ADDR_RES_HEAT_VAL_ADDR, &temp_var, 1, dev);
-
-                dev->calib.res_heat_val = (int8_t)temp_var;
-                if (status == BME680_OK)
-                    status = bme680_get_regs(BME680_ADDR_RANGE_SW_ERR_ADDR, &temp_var, 1, dev);
-            }
-        }
-        dev->calib.range_sw_err = ((int8_t)temp_var & (int8_t)BME680_RSERROR_MSK) / 16;
+        dev->calib.res_heat_range = ((heat_regs[BME680_ADDR_RES_HEAT_RANGE_ADDR] & BME680_RHRANGE_MSK) / 16);
+        dev->calib.res_heat_val = (int8_t)heat_regs[BME680_ADDR_RES_HEAT_VAL_ADDR];
+        dev->calib.range_sw_err = ((int8_t)heat_regs[BME680_ADDR_RANGE_SW_ERR_ADDR] & (int8_t)BME680_RSERROR_MSK) / 16;
     }
 
     return status;
@@ -451,6 +453,36 @@ static int8_t sensor_init(struct bme680_dev *dev, uint8_t i2c_addr, const BME680
     return status; /* Return last error status after all attempts */
 }
 
+// Copie locale (shadow) de l'espace de configuration 0x5A..0x75
+static uint8_t shadow_is_volatile(uint8_t reg_addr)
+{
+    /* 0x73 (status / page SPI) et 0x74 (le mode repasse seul en veille) ne sont jamais servis par la copie */
+    return (reg_addr == UINT8_C(0x73)) || (reg_addr == BME680_CONF_T_P_MODE_ADDR);
+}
+static int8_t shadow_flush(uint32_t dirty, struct bme680_dev *dev)
+{
+    /* Le BME680 n'incrémente pas l'adresse en écriture I2C : il attend des paires adresse/donnée.
+     * Tous les registres modifiés partent dans une seule trame reg0, d0, reg1, d1, ... comme dans
+     * l'API Bosch (la première adresse sert d'adresse mémoire, le reste de la trame suit). */
+    uint8_t tmp_buff[2 * BME680_SHADOW_LEN];
+    uint8_t n = 0;
+
+    for (uint8_t i = 0; i < BME680_SHADOW_LEN; i++)
+    {
+        if (dirty & (UINT32_C(1) << i))
+        {
+            tmp_buff[n++] = (uint8_t)(BME680_SHADOW_START + i);
+            tmp_buff[n++] = dev->shadow[i];
+        }
+    }
+    if (n == 0)
+        return BME680_OK;
+
+    dev->tx_count++;
+    dev->com_status = dev->write(dev->dev_id, tmp_buff[0], &tmp_buff[1], (uint16_t)(n - 1), dev->intf_ptr);
+    return (dev->com_status == BME680_OK) ? BME680_OK : BME680_E_COM_FAIL;
+}
+
 // Fonctions de lecture et d'écriture des registres
 int8_t bme680_get_regs(uint8_t reg_addr, uint8_t *reg_data, uint16_t len, struct bme680_dev *dev)
 {
@@ -458,9 +490,43 @@ int8_t bme680_get_regs(uint8_t reg_addr, uint8_t *reg_data, uint16_t len, struct
     status = null_ptr_check(dev);
     if (status == BME680_OK)
     {
-        dev->com_status = dev->read(dev->dev_id, reg_addr, reg_data, len);
+        /* Lecture servie par la copie locale si tous les registres demandés y sont connus */
+        if (reg_addr >= BME680_SHADOW_START && (uint16_t)(reg_addr + len) <= (uint16_t)BME680_SHADOW_END + 1)
+        {
+            uint16_t i;
+            for (i = 0; i < len; i++)
+            {
+                uint8_t idx = (uint8_t)(reg_addr - BME680_SHADOW_START + i);
+                if (shadow_is_volatile((uint8_t)(reg_addr + i)) || !(dev->shadow_valid & (UINT32_C(1) << idx)))
+                    break;
+            }
+            if (i == len)
+            {
+                memcpy(reg_data, &dev->shadow[reg_addr - BME680_SHADOW_START], len);
+                return BME680_OK;
+            }
+        }
+
+        dev->tx_count++;
+        dev->com_status = dev->read(dev->dev_id, reg_addr, reg_data, len, dev->intf_ptr);
         if (dev->com_status != 0)
+        {
             status = BME680_E_COM_FAIL;
+        }
+        else
+        {
+            /* Mise à jour de la copie locale avec les valeurs lues */
+            for (uint16_t i = 0; i < len; i++)
+            {
+                uint16_t addr = (uint16_t)reg_addr + i;
+                if (addr >= BME680_SHADOW_START && addr <= BME680_SHADOW_END)
+                {
+                    uint8_t idx = (uint8_t)(addr - BME680_SHADOW_START);
+                    dev->shadow[idx] = reg_data[i];
+                    dev->shadow_valid |= (UINT32_C(1) << idx);
+                }
+            }
+        }
     }
     return status;
 }
@@ -468,20 +534,66 @@ int8_t bme680_set_regs(const uint8_t *reg_addr, const uint8_t *reg_data, uint8_t
 {
     int8_t status;
     uint16_t index;
+    uint32_t dirty = 0;
+    uint8_t trigger = 0;
+    uint8_t trigger_data = 0;
+
     status = null_ptr_check(dev);
     if (status == BME680_OK)
     {
         if (len > 0)
         {
-            /* Iterate and write each register-value pair */
-            for (index = 0; index < len; index++)
+            /* Les valeurs sont d'abord appliquées à la copie locale, puis seules les valeurs modifiées
+             * sont envoyées, en une trame de paires adresse/donnée. */
+            for (index = 0; index < len && status == BME680_OK; index++)
             {
-                dev->com_status = dev->write(dev->dev_id, reg_addr[index], (uint8_t *)&reg_data[index], 1);
-                if (dev->com_status != BME680_OK)
+                uint8_t addr = reg_addr[index];
+                uint8_t data = reg_data[index];
+
+                if (addr >= BME680_SHADOW_START && addr <= BME680_SHADOW_END)
                 {
-                    status = BME680_E_COM_FAIL;
-                    break; /* Exit loop on first error */
+                    uint8_t idx = (uint8_t)(addr - BME680_SHADOW_START);
+                    uint32_t bit = UINT32_C(1) << idx;
+
+                    if (addr == BME680_CONF_T_P_MODE_ADDR && (data & BME680_MODE_MSK) != BME680_SLEEP_MODE)
+                    {
+                        /* Le déclenchement d'une mesure est toujours écrit, et en dernier */
+                        trigger = 1;
+                        trigger_data = data;
+                        dev->shadow[idx] = data & (uint8_t)~BME680_MODE_MSK;
+                        dev->shadow_valid |= bit;
+                        dirty &= ~bit;
+                        continue;
+                    }
+                    if (!shadow_is_volatile(addr) && (dev->shadow_valid & bit) && dev->shadow[idx] == data && !(dirty & bit))
+                        continue; /* Valeur déjà présente dans le capteur */
+
+                    dev->shadow[idx] = data;
+                    dev->shadow_valid |= bit;
+                    dirty |= bit;
                 }
+                else
+                {
+                    /* Registre hors copie (ex. reset) : on vide d'abord les écritures en attente pour respecter l'ordre */
+                    status = shadow_flush(dirty, dev);
+                    dirty = 0;
+                    if (status == BME680_OK)
+                    {
+                        dev->tx_count++;
+                        dev->com_status = dev->write(dev->dev_id, addr, &data, 1, dev->intf_ptr);
+                        if (dev->com_status != BME680_OK)
+                            status = BME680_E_COM_FAIL;
+                    }
+                }
+            }
+            if (status == BME680_OK)
+                status = shadow_flush(dirty, dev);
+            if (status == BME680_OK && trigger)
+            {
+                dev->tx_count++;
+                dev->com_status = dev->write(dev->dev_id, BME680_CONF_T_P_MODE_ADDR, &trigger_data, 1, dev->intf_ptr);
+                if (dev->com_status != BME680_OK)
+                    status = BME680_E_COM_FAIL;
             }
         }
         else
@@ -757,6 +869,7 @@ int8_t bme680_soft_reset(struct bme680_dev *dev)
     if (status == BME680_OK)
     {
         status = bme680_set_regs(&reg_addr, &soft_rst_cmd, 1, dev);
+        dev->shadow_valid = 0; /* Tous les registres reprennent leur valeur par défaut */
         dev->delay_ms(BME680_RESET_PERIOD);
     }
     return status;
@@ -776,6 +889,9 @@ int8_t bme680_init(struct bme680_dev *dev)
                 if (dev->chip_id == BME680_CHIP_ID)
                 {
                     status = get_calib_data(dev);
+                    /* Une lecture groupée de l'espace de configuration initialise la copie locale */
+                    if (status == BME680_OK)
+                        status = bme680_get_regs(BME680_SHADOW_START, dev->shadow, BME680_SHADOW_LEN, dev);
                     if (status == BME680_OK)
                     {
                         dev->tph_sett.os_hum = BME680_OS_1X;
@@ -797,22 +913,26 @@ int8_t bme680_init(struct bme680_dev *dev)
     }
     return status;
 }
+static void bind_bus(struct bme680_dev *dev, I2C_HandleTypeDef *i2c_handle)
+{
+    dev->hi2c = i2c_handle;
+    dev->intf_ptr = i2c_handle; /* Contexte de bus propre au capteur */
+    dev->shadow_valid = 0;
+    dev->read = stm32_bme680_i2c_read;
+    dev->write = stm32_bme680_i2c_write;
+    dev->delay_ms = user_delay_ms; // Utilisation directe de user_delay_ms
+    dev->intf = BME680_I2C_INTF;
+}
 int8_t BME680_Start(struct bme680_dev *dev, I2C_HandleTypeDef *i2c_handle,
                     const BME680_InitialSettings *settings)
 {
     int8_t status = BME680_E_DEV_NOT_FOUND;
-    /* int attempt_count = 0; // No longer needed here */
     if (!dev || !i2c_handle)
     {
         return BME680_E_NULL_PTR;
     }
 
-    s_bme680_i2c_handle = i2c_handle;
-    dev->hi2c = i2c_handle;
-    dev->read = stm32_bme680_i2c_read;
-    dev->write = stm32_bme680_i2c_write;
-    dev->delay_ms = user_delay_ms; // Utilisation directe de user_delay_ms
-    dev->intf = BME680_I2C_INTF;
+    bind_bus(dev, i2c_handle);
 
     /* Try initializing with the primary I2C address */
     status = sensor_init(dev, BME680_I2C_ADDR_PRIMARY, settings);
@@ -829,9 +949,261 @@ int8_t BME680_Start(struct bme680_dev *dev, I2C_HandleTypeDef *i2c_handle,
     }
 
     /* If both addresses fail, cleanup and return the last error status */
-    s_bme680_i2c_handle = NULL; /* Clear the global handle as initialization failed */
+    dev->intf_ptr = NULL; /* Clear the bus binding as initialization failed */
+    return status;
+}
+int8_t BME680_Start_Addr(struct bme680_dev *dev, I2C_HandleTypeDef *i2c_handle, uint8_t i2c_addr,
+                         const BME680_InitialSettings *settings)
+{
+    int8_t status;
+    if (!dev || !i2c_handle)
+    {
+        return BME680_E_NULL_PTR;
+    }
+
+    bind_bus(dev, i2c_handle);
+    status = sensor_init(dev, i2c_addr, settings);
+    if (status != BME680_OK)
+    {
+        dev->intf_ptr = NULL;
+    }
+    return status;
+}
+
+// Séquenceur de profils de chauffage
+int8_t BME680_Sequencer_Init(BME680_HeaterSequencer *seq, struct bme680_dev *dev,
+                             const BME680_HeaterStep *steps, uint8_t count)
+{
+    int8_t status;
+    uint8_t regs[BME680_CONF_T_P_MODE_ADDR - BME680_CONF_HEAT_CTRL_ADDR + 1]; /* 0x70 à 0x74 */
+    uint16_t tph_dur;
+
+    if (seq == NULL || steps == NULL)
+        return BME680_E_NULL_PTR;
+    status = null_ptr_check(dev);
+    if (status != BME680_OK)
+        return status;
+    if (count == 0 || count > BME680_HEATER_PROFILE_MAX)
+        return BME680_E_INVALID_LENGTH;
+
+    seq->dev = dev;
+    seq->count = count;
+    seq->index = 0;
+
+    /* Pré-calcul des valeurs de registre res_heat_x / gas_wait_x et des durées de mesure */
+    tph_dur = calculate_tph_measurement_duration(dev);
+    for (uint8_t i = 0; i < count; i++)
+    {
+        seq->res_heat[i] = (uint8_t)calc_heater_res(steps[i].heatr_temp, dev);
+        seq->gas_wait[i] = calc_heater_dur(steps[i].heatr_dur);
+        seq->dur_ms[i] = (uint16_t)(tph_dur + steps[i].heatr_dur);
+    }
+
+    /* Le capteur doit être en veille pour modifier la configuration */
+    dev->power_mode = BME680_SLEEP_MODE;
+    status = bme680_set_sensor_mode(dev);
+
+    /* Chargement de toutes les consignes (res_heat_x en 0x5A.., gas_wait_x en 0x64..) : bme680_set_regs
+     * les envoie en une seule trame de paires adresse/donnée, chaque registre étant adressé explicitement */
+    if (status == BME680_OK)
+    {
+        uint8_t reg_addr[2 * BME680_HEATER_PROFILE_MAX];
+        uint8_t reg_data[2 * BME680_HEATER_PROFILE_MAX];
+        for (uint8_t i = 0; i < count; i++)
+        {
+            reg_addr[i] = (uint8_t)(BME680_RES_HEAT0_ADDR + i);
+            reg_data[i] = seq->res_heat[i];
+            reg_addr[count + i] = (uint8_t)(BME680_GAS_WAIT0_ADDR + i);
+            reg_data[count + i] = seq->gas_wait[i];
+        }
+        status = bme680_set_regs(reg_addr, reg_data, (uint8_t)(2 * count), dev);
+    }
+
+    /* Lecture unique de ctrl_gas_0 à ctrl_meas pour initialiser les copies locales */
+    if (status == BME680_OK)
+        status = bme680_get_regs(BME680_CONF_HEAT_CTRL_ADDR, regs, sizeof(regs), dev);
+    if (status == BME680_OK)
+    {
+        uint8_t reg_addr = BME680_CONF_HEAT_CTRL_ADDR;
+        uint8_t heat_ctrl = BME680_SET_BITS_POS_0(regs[0], BME680_HCTRL, BME680_ENABLE_HEATER);
+        status = bme680_set_regs(&reg_addr, &heat_ctrl, 1, dev); /* Sans effet si déjà activé */
+        seq->ctrl_gas_1 = regs[BME680_CONF_ODR_RUN_GAS_NBC_ADDR - BME680_CONF_HEAT_CTRL_ADDR];
+        seq->ctrl_meas = regs[BME680_CONF_T_P_MODE_ADDR - BME680_CONF_HEAT_CTRL_ADDR] & (uint8_t)~BME680_MODE_MSK;
+    }
+
+    dev->gas_sett.run_gas = BME680_RUN_GAS_ENABLE;
+    dev->power_mode = BME680_FORCED_MODE;
+    return status;
+}
+int8_t BME680_Sequencer_Trigger(BME680_HeaterSequencer *seq, uint16_t *wait_ms)
+{
+    int8_t status;
+    uint8_t reg_addr[2] = {BME680_CONF_ODR_RUN_GAS_NBC_ADDR, BME680_CONF_T_P_MODE_ADDR};
+    uint8_t reg_data[2];
+
+    if (seq == NULL || seq->dev == NULL)
+        return BME680_E_NULL_PTR;
+
+    /* Sélection de la consigne (ctrl_gas_1, écrit seulement s'il change) puis déclenchement :
+     * en mode forcé le capteur repasse seul en veille, pas de cycle veille/forcé */
+    reg_data[0] = BME680_SET_BITS(seq->ctrl_gas_1, BME680_RUN_GAS, BME680_RUN_GAS_ENABLE);
+    reg_data[0] = BME680_SET_BITS_POS_0(reg_data[0], BME680_NBCONV, seq->index);
+    reg_data[1] = seq->ctrl_meas | BME680_FORCED_MODE;
+    status = bme680_set_regs(reg_addr, reg_data, 2, seq->dev);
+
+    if (wait_ms != NULL)
+        *wait_ms = seq->dur_ms[seq->index];
+    return status;
+}
+int8_t BME680_Sequencer_Read(BME680_HeaterSequencer *seq, struct bme680_field_data *data, uint8_t *step)
+{
+    int8_t status;
+    uint8_t buff[BME680_FIELD_LENGTH];
+
+    if (seq == NULL || seq->dev == NULL || data == NULL)
+        return BME680_E_NULL_PTR;
+
+    /* Une seule lecture du champ, sans nouvelle tentative ni attente */
+    status = bme680_get_regs(BME680_FIELD0_ADDR, buff, BME680_FIELD_LENGTH, seq->dev);
+    if (status != BME680_OK)
+        return status;
+    parse_field_data(buff, data, seq->dev);
+    if (!(data->status & BME680_NEW_DATA_MSK))
+        return BME680_W_NO_NEW_DATA;
+
+    if (step != NULL)
+        *step = data->gas_index;
+    seq->index = (uint8_t)((seq->index + 1) % seq->count);
+    return BME680_OK;
+}
+
+// Pipeline de mesure non bloquant
+int8_t BME680_Pipeline_Init(BME680_Pipeline *pipe, struct bme680_dev *dev, uint32_t period_ms,
+                            BME680_DataCallback callback, void *ctx)
+{
+    int8_t status;
+    uint8_t ctrl_meas;
+
+    if (pipe == NULL || callback == NULL)
+        return BME680_E_NULL_PTR;
+    status = null_ptr_check(dev);
+    if (status != BME680_OK)
+        return status;
+
+    /* Copie locale de ctrl_meas (suréchantillonnage T/P) : le déclenchement ne coûte qu'une écriture */
+    status = bme680_get_regs(BME680_CONF_T_P_MODE_ADDR, &ctrl_meas, 1, dev);
+    if (status != BME680_OK)
+        return status;
+
+    pipe->dev = dev;
+    pipe->callback = callback;
+    pipe->ctx = ctx;
+    pipe->period_ms = period_ms;
+    pipe->ctrl_meas = ctrl_meas & (uint8_t)~BME680_MODE_MSK;
+    bme680_get_profile_dur(&pipe->profile_dur, dev);
+    pipe->state = BME680_PIPE_IDLE;
+    pipe->retries = 0;
+    pipe->next_tick = HAL_GetTick();
+    return BME680_OK;
+}
+int8_t BME680_Pipeline_Trigger(BME680_Pipeline *pipe)
+{
+    uint8_t reg_addr = BME680_CONF_T_P_MODE_ADDR;
+    uint8_t ctrl_meas;
+
+    if (pipe == NULL || pipe->dev == NULL)
+        return BME680_E_NULL_PTR;
+    if (pipe->state != BME680_PIPE_IDLE)
+        return BME680_W_DEFINE_PWR_MODE; /* Mesure déjà en cours */
+
+    /* En mode forcé le capteur repasse seul en veille : une écriture de ctrl_meas suffit */
+    ctrl_meas = pipe->ctrl_meas | BME680_FORCED_MODE;
+    if (bme680_set_regs(&reg_addr, &ctrl_meas, 1, pipe->dev) != BME680_OK)
+        return BME680_E_COM_FAIL;
+
+    pipe->trigger_tick = HAL_GetTick();
+    pipe->wait_ms = pipe->profile_dur;
+    pipe->retries = 0;
+    pipe->state = BME680_PIPE_MEASURING;
+    return BME680_OK;
+}
+void BME680_Pipeline_Process(BME680_Pipeline *pipe)
+{
+    struct bme680_field_data field;
+    uint8_t buff[BME680_FIELD_LENGTH];
+    BME680Data data = {0};
+    int8_t status;
+    uint32_t now = HAL_GetTick();
+
+    if (pipe == NULL || pipe->dev == NULL)
+        return;
+
+    if (pipe->state == BME680_PIPE_IDLE)
+    {
+        /* Mesure périodique : déclenchement à l'échéance */
+        if (pipe->period_ms != 0 && (int32_t)(now - pipe->next_tick) >= 0)
+        {
+            pipe->next_tick += pipe->period_ms;
+            if ((int32_t)(now - pipe->next_tick) >= 0)
+                pipe->next_tick = now + pipe->period_ms; /* Retard trop important : on se recale */
+            if (BME680_Pipeline_Trigger(pipe) != BME680_OK)
+                pipe->callback(pipe->dev, &data, BME680_E_COM_FAIL, pipe->ctx);
+        }
+        return;
+    }
+
+    if ((now - pipe->trigger_tick) < pipe->wait_ms)
+        return; /* Le bus n'est pas sollicité avant la fin de la durée du profil */
+
+    /* Une seule lecture du champ ; si la donnée n'est pas encore prête, nouvel essai BME680_POLL_PERIOD_MS plus tard */
+    status = bme680_get_regs(BME680_FIELD0_ADDR, buff, BME680_FIELD_LENGTH, pipe->dev);
+    if (status == BME680_OK)
+    {
+        parse_field_data(buff, &field, pipe->dev);
+        if (!(field.status & BME680_NEW_DATA_MSK))
+        {
+            if (++pipe->retries < BME680_PIPE_MAX_RETRIES)
+            {
+                pipe->wait_ms += BME680_POLL_PERIOD_MS;
+                return;
+            }
+            status = BME680_W_NO_NEW_DATA;
+        }
+        else
+        {
+            data.temperature = field.temperature;
+            data.pressure = field.pressure;
+            data.humidity = field.humidity;
+            data.gas_resistance = field.gas_resistance;
+        }
+    }
+
+    pipe->dev->new_fields = (status == BME680_OK);
+    pipe->state = BME680_PIPE_IDLE;
+    pipe->callback(pipe->dev, &data, status, pipe->ctx);
+}
+
+#ifdef BME680_BENCHMARK
+// Mesure du coût de BME680_Start sur la cible
+int8_t BME680_Benchmark_Start(struct bme680_dev *dev, I2C_HandleTypeDef *i2c_handle,
+                              const BME680_InitialSettings *settings, uint32_t *transactions, uint32_t *elapsed_ms)
+{
+    int8_t status;
+    uint32_t start;
+
+    if (dev == NULL)
+        return BME680_E_NULL_PTR;
+
+    dev->tx_count = 0;
+    start = HAL_GetTick();
+    status = BME680_Start(dev, i2c_handle, settings);
+    if (elapsed_ms != NULL)
+        *elapsed_ms = HAL_GetTick() - start;
+    if (transactions != NULL)
+        *transactions = dev->tx_count;
     return status;
 }
+#endif
 
 // Fonction pour le calcul de l'IAQ
 float waterSatDensity(float temp)
@@ -931,6 +1303,85 @@ void initIAQTracker(IAQTracker *tracker, int burn_in_total_cycles, float ph_slop
     tracker->gas_baseline = 0.0f;
 }
 
+// Suivi IAQ à coût constant par échantillon
+/*
+ * Approximation de expf sans bibliothèque mathématique : exp(x) = 2^n * 2^f avec n entier et f dans [0, 1[.
+ * 2^f est évalué par un polynôme de degré 4 (erreur relative < 4e-6), 2^n est injecté dans l'exposant IEEE-754.
+ */
+static float fast_expf(float x)
+{
+    union
+    {
+        float f;
+        uint32_t u;
+    } scale;
+
+    if (x > 88.0f)
+        x = 88.0f;
+    if (x < -87.0f)
+        return 0.0f;
+
+    float t = x * 1.44269504f; /* log2(e) */
+    int32_t n = (int32_t)t;
+    if (t < (float)n)
+        n--; /* floor pour les valeurs négatives */
+    float f = t - (float)n;
+
+    float p = 1.0f + f * (0.69304484f + f * (0.24128028f + f * (0.05224231f + f * 0.01342679f)));
+    scale.u = (uint32_t)(n + 127) << 23;
+    return p * scale.f;
+}
+float waterSatDensityFast(float temp)
+{
+    /* Même formule que waterSatDensity (Magnus + gaz parfait), en simple précision : 611.2 / 461.52 = 1.32432 */
+    return (1.3243196f * fast_expf((17.62f * temp) / (243.12f + temp))) / (temp + 273.15f);
+}
+void initIAQTrackerFast(IAQTrackerFast *tracker, int burn_in_total_cycles, float ph_slope, uint32_t window)
+{
+    if (window == 0)
+        window = 1;
+    tracker->slope = ph_slope;
+    tracker->burn_in_cycles_remaining = burn_in_total_cycles;
+    tracker->window = window;
+    tracker->inv_window = 1.0f / (float)window;
+    tracker->count = 0;
+    tracker->gas_baseline = 0.0f;
+}
+float getIAQFast(IAQTrackerFast *tracker, BME680Data bme_data)
+{
+    float hum_abs = bme_data.humidity * 10.0f * waterSatDensityFast(bme_data.temperature); /* (hum / 100) * 1000 * rho_max */
+    float comp_gas = bme_data.gas_resistance * fast_expf(tracker->slope * hum_abs);
+
+    /* Moyenne cumulative tant que la fenêtre n'est pas remplie, puis moyenne mobile exponentielle de constante 'window' */
+    if (tracker->count < tracker->window)
+    {
+        tracker->count++;
+        tracker->gas_baseline += (comp_gas - tracker->gas_baseline) / (float)tracker->count;
+    }
+    else
+    {
+        tracker->gas_baseline += (comp_gas - tracker->gas_baseline) * tracker->inv_window;
+    }
+
+    if (tracker->burn_in_cycles_remaining > 0)
+    {
+        tracker->burn_in_cycles_remaining--;
+        return NAN;
+    }
+
+    if (tracker->gas_baseline == 0.0f)
+    {
+        return (comp_gas == 0.0f) ? 0.0f : 100.0f;
+    }
+
+    float ratio = comp_gas / tracker->gas_baseline;
+    float iaq_contribution_gas = ratio * ratio;
+    if (iaq_contribution_gas > 1.0f)
+        iaq_contribution_gas = 1.0f;
+
+    return (1.0f - iaq_contribution_gas) * 100.0f;
+}
+
 // Fonction de temporisation
 void user_delay_ms(uint32_t period)
 {
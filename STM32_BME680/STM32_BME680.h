@@ -6,8 +6,12 @@
 #include <math.h>
 #include "STM32_BME680_defs.h"
 
+// #define BME680_BENCHMARK // Décommenter pour compiler BME680_Benchmark_Start
+
 /* Définitions des constantes -------------------------------------------------*/
 #define GAS_CAL_DATA_WINDOW_SIZE 100
+#define BME680_PIPE_MAX_RETRIES 10   // Lectures supplémentaires du pipeline si la donnée n'est pas prête
+#define BME680_HEATER_PROFILE_MAX 10 // Nombre de consignes de chauffage du capteur (res_heat_0..9 / gas_wait_0..9)
 
 /* Structues ------------------------------------------------------------*/
 
@@ -40,6 +44,24 @@ typedef struct
     float gas_baseline;
 } IAQTracker;
 
+/**
+ * @brief Variante de IAQTracker dont le coût par échantillon est constant.
+ *
+ * La ligne de base est une moyenne cumulative pendant les 'window' premiers échantillons,
+ * puis une moyenne mobile exponentielle de constante de temps 'window' échantillons.
+ * La mémoire et le temps de calcul ne dépendent pas de la taille de la fenêtre
+ * (ex. 24 h à 3 s par mesure : window = 28800).
+ */
+typedef struct
+{
+    float slope;
+    int burn_in_cycles_remaining;
+    uint32_t window;
+    float inv_window;
+    uint32_t count;
+    float gas_baseline;
+} IAQTrackerFast;
+
 /**
  * @brief Structure pour contenir les paramètres initiaux du capteur BME680.
  *
@@ -52,6 +74,74 @@ typedef struct
     uint8_t power_mode;
 } BME680_InitialSettings;
 
+/**
+ * @brief Un pas d'un profil de chauffage : température de consigne et durée de chauffe.
+ */
+typedef struct
+{
+    uint16_t heatr_temp; // Température de consigne en °C (max 400)
+    uint16_t heatr_dur;  // Durée de chauffe en ms (max 4032)
+} BME680_HeaterStep;
+
+/**
+ * @brief Séquenceur de profils de chauffage.
+ *
+ * Les valeurs res_heat_x/gas_wait_x de chaque pas sont pré-calculées et chargées une fois dans
+ * les 10 consignes du capteur. Entre deux mesures, seul nb_conv (ctrl_gas_1) est réécrit, et
+ * uniquement s'il change (copie locale des registres), puis ctrl_meas pour déclencher la mesure forcée.
+ */
+typedef struct
+{
+    struct bme680_dev *dev;
+    uint8_t res_heat[BME680_HEATER_PROFILE_MAX]; // Valeurs pré-calculées des registres res_heat_x
+    uint8_t gas_wait[BME680_HEATER_PROFILE_MAX]; // Valeurs pré-calculées des registres gas_wait_x
+    uint16_t dur_ms[BME680_HEATER_PROFILE_MAX];  // Durée totale de la mesure de chaque pas (TPH + chauffe)
+    uint8_t count;                               // Nombre de pas du profil
+    uint8_t index;                               // Pas de la prochaine mesure
+    uint8_t ctrl_gas_1;                          // Valeur de base du registre 0x71 (hors nb_conv)
+    uint8_t ctrl_meas;                           // Copie locale du registre 0x74 (sans les bits de mode)
+} BME680_HeaterSequencer;
+
+/**
+ * @brief Callback de fin de mesure du pipeline non bloquant.
+ * @param dev Capteur ayant produit la mesure.
+ * @param data Données compensées (valides uniquement si status == BME680_OK).
+ * @param status BME680_OK, BME680_W_NO_NEW_DATA ou BME680_E_COM_FAIL.
+ * @param ctx Pointeur utilisateur fourni à BME680_Pipeline_Init.
+ */
+typedef void (*BME680_DataCallback)(struct bme680_dev *dev, const BME680Data *data, int8_t status, void *ctx);
+
+/**
+ * @brief États du pipeline de mesure.
+ */
+typedef enum
+{
+    BME680_PIPE_IDLE = 0,     // Aucune mesure en cours
+    BME680_PIPE_MEASURING = 1 // Mesure forcée en cours, lecture planifiée
+} BME680_PipelineState;
+
+/**
+ * @brief Pipeline de mesure non bloquant piloté par un tick.
+ *
+ * La mesure forcée est déclenchée par une écriture de ctrl_meas, la lecture est planifiée à la durée
+ * du profil (bme680_get_profile_dur) et le champ de données n'est lu qu'une fois à l'échéance.
+ * Aucun appel à delay_ms : le MCU peut dormir ou servir d'autres capteurs entre deux ticks.
+ */
+typedef struct
+{
+    struct bme680_dev *dev;
+    BME680_DataCallback callback;
+    void *ctx;
+    uint32_t period_ms;    // Intervalle entre deux mesures (0 : déclenchement manuel uniquement)
+    uint32_t next_tick;    // Échéance du prochain déclenchement périodique
+    uint32_t trigger_tick; // HAL_GetTick() au déclenchement
+    uint32_t wait_ms;      // Délai avant la lecture (durée du profil + nouveaux essais)
+    uint16_t profile_dur;  // Durée du profil TPH + gaz en ms
+    uint8_t ctrl_meas;     // Copie locale de ctrl_meas (sans les bits de mode)
+    uint8_t retries;       // Nombre de lectures sans nouvelle donnée
+    volatile BME680_PipelineState state;
+} BME680_Pipeline;
+
 /* Prototypes des fonctions ---------------------------------------------*/
 
 /*
@@ -61,8 +151,49 @@ typedef struct
 int8_t BME680_Start(struct bme680_dev *dev, I2C_HandleTypeDef *i2c_handle,
                     const BME680_InitialSettings *settings);
 
+/*
+ * Variante de BME680_Start à adresse fixe, pour utiliser plusieurs capteurs : chaque struct bme680_dev
+ * porte son propre contexte de bus (intf_ptr), par ex. 0x76 et 0x77 sur le même bus ou deux bus distincts.
+ */
+int8_t BME680_Start_Addr(struct bme680_dev *dev, I2C_HandleTypeDef *i2c_handle, uint8_t i2c_addr,
+                         const BME680_InitialSettings *settings);
+
 int8_t BME680_Config_Advanced(struct bme680_dev *dev, struct bme680_tph_sett *tph_settings, struct bme680_gas_sett *gas_settings, uint8_t power_mode);
 
+/*
+ * Séquenceur de profils de chauffage (mesures de gaz multi-consignes)
+ * Init : pré-calcule et charge le profil. Trigger : lance la mesure du pas courant et retourne
+ * la durée à attendre. Read : lit le résultat une seule fois et passe au pas suivant.
+ */
+int8_t BME680_Sequencer_Init(BME680_HeaterSequencer *seq, struct bme680_dev *dev,
+                             const BME680_HeaterStep *steps, uint8_t count);
+
+int8_t BME680_Sequencer_Trigger(BME680_HeaterSequencer *seq, uint16_t *wait_ms);
+
+int8_t BME680_Sequencer_Read(BME680_HeaterSequencer *seq, struct bme680_field_data *data, uint8_t *step);
+
+/*
+ * Pipeline de mesure non bloquant
+ * Init : à appeler après BME680_Start ou BME680_Config_Advanced (à refaire si la configuration change).
+ * Process : à appeler depuis le tick d'un timer ou la boucle principale ; déclenche les mesures
+ * périodiques, lit le résultat à l'échéance et appelle le callback.
+ * Trigger : déclenchement manuel (period_ms = 0).
+ */
+int8_t BME680_Pipeline_Init(BME680_Pipeline *pipe, struct bme680_dev *dev, uint32_t period_ms,
+                            BME680_DataCallback callback, void *ctx);
+
+int8_t BME680_Pipeline_Trigger(BME680_Pipeline *pipe);
+
+void BME680_Pipeline_Process(BME680_Pipeline *pipe);
+
+#ifdef BME680_BENCHMARK
+/*
+ * Mesure sur la cible du nombre de transactions I2C et de la durée de BME680_Start.
+ */
+int8_t BME680_Benchmark_Start(struct bme680_dev *dev, I2C_HandleTypeDef *i2c_handle,
+                              const BME680_InitialSettings *settings, uint32_t *transactions, uint32_t *elapsed_ms);
+#endif
+
 /*
  * Fonctions de l'API Bosch BME680 (Wrappers ou implémentations directes)
  * Ces fonctions fournissent une interface similaire à l'API standard de Bosch
@@ -77,11 +208,16 @@ int8_t bme680_init(struct bme680_dev *dev);
 
 /**
  * @brief Écrit des données dans un registre ou une série de registres.
+ * Les valeurs sont comparées à la copie locale de l'espace de configuration (0x5A..0x75) : seules les
+ * valeurs modifiées sont envoyées, en une seule trame de paires adresse/donnée (le capteur n'incrémente
+ * pas l'adresse en écriture). Un déclenchement de mesure
+ * (ctrl_meas en mode forcé) est toujours écrit, en dernier.
  */
 int8_t bme680_set_regs(const uint8_t *reg_addr, const uint8_t *reg_data, uint8_t len, struct bme680_dev *dev);
 
 /**
  * @brief Lit des données depuis un registre ou une série de registres.
+ * Les registres de configuration connus sont servis par la copie locale, sans accès au bus.
  */
 int8_t bme680_get_regs(uint8_t reg_addr, uint8_t *reg_data, uint16_t len, struct bme680_dev *dev);
 
@@ -137,6 +273,16 @@ float waterSatDensity(float temp);
 
 const char *getIAQCategory(float iaq);
 
+/*
+ * Variante à coût constant : ligne de base en moyenne mobile, humidité absolue et compensation
+ * calculées en simple précision avec une approximation de exp (aucun appel à exp/expf/powf).
+ */
+void initIAQTrackerFast(IAQTrackerFast *tracker, int burn_in_total_cycles, float ph_slope, uint32_t window);
+
+float getIAQFast(IAQTrackerFast *tracker, BME680Data bme_data);
+
+float waterSatDensityFast(float temp);
+
 /*
  * Fonction de Temporisation (Callback Utilisateur)
  * Cette fonction est une implémentation de la fonction de délai requise par l'API BME680,
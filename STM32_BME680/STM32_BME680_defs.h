@@ -49,6 +49,10 @@
 #define BME680_CONF_T_P_MODE_ADDR UINT8_C(0x74)		   // Adresse de configuration du mode T_P
 #define BME680_CONF_ODR_FILT_ADDR UINT8_C(0x75)		   // Adresse de configuration ODR et filtre
 
+#define BME680_SHADOW_START UINT8_C(0x5a)									  // Premier registre de la copie locale (res_heat_0)
+#define BME680_SHADOW_END UINT8_C(0x75)										  // Dernier registre de la copie locale (config)
+#define BME680_SHADOW_LEN (BME680_SHADOW_END - BME680_SHADOW_START + 1) // Taille de la copie locale (28 registres)
+
 #define BME680_COEFF_ADDR1 UINT8_C(0x89) // Première adresse des coefficients de calibration
 #define BME680_COEFF_ADDR2 UINT8_C(0xe1) // Deuxième adresse des coefficients de calibration
 
@@ -183,7 +187,7 @@
 #define BME680_SET_BITS_POS_0(reg_data, bitname, data) ((reg_data & ~(bitname##_MSK)) | (data & bitname##_MSK)) // Définir les bits à la position 0
 #define BME680_GET_BITS_POS_0(reg_data, bitname) (reg_data & (bitname##_MSK))									// Obtenir les bits à la position 0
 
-typedef int8_t (*bme680_com_fptr_t)(uint8_t dev_id, uint8_t reg_addr, uint8_t *data, uint16_t len); // Pointeur de fonction pour la communication
+typedef int8_t (*bme680_com_fptr_t)(uint8_t dev_id, uint8_t reg_addr, uint8_t *data, uint16_t len, void *intf_ptr); // Pointeur de fonction pour la communication (intf_ptr : contexte de bus du capteur)
 
 typedef void (*bme680_delay_fptr_t)(uint32_t period); // Pointeur de fonction pour le délai
 
@@ -270,7 +274,11 @@ struct bme680_dev // Structure pour le périphérique BME680
 	bme680_com_fptr_t write;		 // Fonction d'écriture
 	bme680_delay_fptr_t delay_ms;	 // Fonction de délai
 	int8_t com_status;				 // Statut de communication
+	uint8_t shadow[BME680_SHADOW_LEN]; // Copie locale des registres de configuration 0x5A..0x75
+	uint32_t shadow_valid;			 // Bit i à 1 si shadow[i] reflète le capteur
+	uint32_t tx_count;				 // Nombre de transactions I2C effectuées
 	I2C_HandleTypeDef *hi2c;		 // Pointeur vers le gestionnaire I2C
+	void *intf_ptr;					 // Contexte de bus transmis à read/write (handle I2C par défaut)
 };
 
 #endif // Fin de la définition de STM32_BME680_DEFS_H_
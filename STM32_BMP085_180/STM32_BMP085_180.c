@@ -1,4 +1,5 @@
 #include "STM32_BMP085_180.h" // Inclut le fichier d'en-tête pour les fonctions du capteur BMP085
+#include "STM32_CRC8.h"       // CRC8 partagé (dossier STM32_CRC8), contrôle du blob de calibration
 
 // Cette librairie est conçue pour être compatible avec les capteurs Bosch BMP085 et BMP180.
 // Ces deux capteurs partagent le même ID de puce (0x55) et une interface I2C similaire.
@@ -42,6 +43,7 @@
 // --- Fonctions statiques internes ---
 
 // Fonctions de gestion I2C
+// Lecture combinée (adresse du registre puis lecture après un START répété) en une seule transaction.
 // Retourne BMP_OK en cas de succès, ou un code d'erreur BMP_Status_t
 static BMP_Status_t readBytes(BMP_Handle_t *bmp, uint8_t regAddr, uint8_t *buffer, uint8_t len)
 {
@@ -51,15 +53,11 @@ static BMP_Status_t readBytes(BMP_Handle_t *bmp, uint8_t regAddr, uint8_t *buffe
     }
 
     DEBUG_PRINT("readBytes: Reading %d byte(s) from reg 0x%02X...\r\n", len, regAddr);
-    if (HAL_I2C_Master_Transmit(bmp->i2cHandle, bmp->i2cAddr8bit, &regAddr, 1, BMP_I2C_TIMEOUT) != HAL_OK) {
-        bmp->lastError = BMP_ERR_I2C_TX;
-        DEBUG_PRINT("readBytes Error: I2C Transmit failed\r\n");
-        return BMP_ERR_I2C_TX;
-    }
-    if (HAL_I2C_Master_Receive(bmp->i2cHandle, bmp->i2cAddr8bit, buffer, len, BMP_I2C_TIMEOUT) != HAL_OK) {
-        bmp->lastError = BMP_ERR_I2C_RX;
-        DEBUG_PRINT("readBytes Error: I2C Receive failed\r\n");
-        return BMP_ERR_I2C_RX;
+    if (HAL_I2C_Mem_Read(bmp->i2cHandle, bmp->i2cAddr8bit, regAddr, I2C_MEMADD_SIZE_8BIT, buffer, len, BMP_I2C_TIMEOUT) != HAL_OK) {
+        // Un NACK ne peut survenir que sur l'adresse ou le registre (phase d'émission)
+        bmp->lastError = (HAL_I2C_GetError(bmp->i2cHandle) & HAL_I2C_ERROR_AF) ? BMP_ERR_I2C_TX : BMP_ERR_I2C_RX;
+        DEBUG_PRINT("readBytes Error: I2C read failed (%d)\r\n", bmp->lastError);
+        return bmp->lastError;
     }
     return BMP_OK;
 }
@@ -106,9 +104,33 @@ static BMP_Status_t write8(BMP_Handle_t *bmp, uint8_t regAddr, uint8_t data) //
     return BMP_OK; // Succès
 }
 
+// Décode les 11 coefficients (big-endian) à partir du bloc brut 0xAA..0xBF
+static void parseCalibration(BMP_Handle_t *bmp, const uint8_t *raw)
+{
+  #define CAL16(i) (((uint16_t)raw[(i)] << 8) | raw[(i) + 1])
+  bmp->ac1 = (int16_t)CAL16(BMP_CAL_AC1 - BMP_CAL_AC1);
+  bmp->ac2 = (int16_t)CAL16(BMP_CAL_AC2 - BMP_CAL_AC1);
+  bmp->ac3 = (int16_t)CAL16(BMP_CAL_AC3 - BMP_CAL_AC1);
+  bmp->ac4 = CAL16(BMP_CAL_AC4 - BMP_CAL_AC1);
+  bmp->ac5 = CAL16(BMP_CAL_AC5 - BMP_CAL_AC1);
+  bmp->ac6 = CAL16(BMP_CAL_AC6 - BMP_CAL_AC1);
+  bmp->b1 = (int16_t)CAL16(BMP_CAL_B1 - BMP_CAL_AC1);
+  bmp->b2 = (int16_t)CAL16(BMP_CAL_B2 - BMP_CAL_AC1);
+  bmp->mb = (int16_t)CAL16(BMP_CAL_MB - BMP_CAL_AC1);
+  bmp->mc = (int16_t)CAL16(BMP_CAL_MC - BMP_CAL_AC1);
+  bmp->md = (int16_t)CAL16(BMP_CAL_MD - BMP_CAL_AC1);
+  #undef CAL16
+}
+
 // --- Fonctions Publiques ---
 
 BMP_Status_t BMP_Init(BMP_Handle_t *bmp, uint8_t mode, I2C_HandleTypeDef *i2cdev, uint8_t i2c_address_7bit)
+{
+  return BMP_InitWithStorage(bmp, mode, i2cdev, i2c_address_7bit, NULL);
+}
+
+BMP_Status_t BMP_InitWithStorage(BMP_Handle_t *bmp, uint8_t mode, I2C_HandleTypeDef *i2cdev, uint8_t i2c_address_7bit,
+                                 const BMP_CalibStorage_t *storage)
 {
   DEBUG_PRINT("BMP_Init: Starting initialization...\r\n");
   if (bmp == NULL || i2cdev == NULL) {
@@ -120,6 +142,8 @@ BMP_Status_t BMP_Init(BMP_Handle_t *bmp, uint8_t mode, I2C_HandleTypeDef *i2cdev
   bmp->i2cHandle = i2cdev; // Associe le périphérique I2C
   bmp->i2cAddr8bit = i2c_address_7bit << 1; // Configure l'adresse I2C (8 bits)
   bmp->lastError = BMP_OK; // Initialise le statut d'erreur
+  bmp->pipeState = BMP_PIPE_IDLE;
+  bmp->b5Valid = 0;
 
   if (mode > BMP_ULTRAHIGHRES) { // Vérifie si le mode est valide
     DEBUG_PRINT("BMP_Init Warning: Invalid mode (%d), using BMP_ULTRAHIGHRES\r\n", mode);
@@ -140,25 +164,31 @@ BMP_Status_t BMP_Init(BMP_Handle_t *bmp, uint8_t mode, I2C_HandleTypeDef *i2cdev
   printf("Capteur détecté : BMP085/BMP180 avec ID 0x%X\r\n", chipId);
   DEBUG_PRINT("BMP_Init: Chip ID OK (0x%02X)\r\n", chipId);
 
-  /* Lit les données de calibration */
-  // Vérifier chaque lecture de calibration pour les erreurs I2C
-  // Correction: read16 prend bmp, regAddr, value*
-  #define CHECK_CAL_READ(reg, var_ptr) if ((status = read16(bmp, reg, (uint16_t*)var_ptr)) != BMP_OK) { bmp->lastError = status; return status; }
-  CHECK_CAL_READ(BMP_CAL_AC1, &bmp->ac1);
-  CHECK_CAL_READ(BMP_CAL_AC2, &bmp->ac2);
-  CHECK_CAL_READ(BMP_CAL_AC3, &bmp->ac3);
-  CHECK_CAL_READ(BMP_CAL_AC4, &bmp->ac4);
-  CHECK_CAL_READ(BMP_CAL_AC5, &bmp->ac5);
-  CHECK_CAL_READ(BMP_CAL_AC6, &bmp->ac6);
-
-  CHECK_CAL_READ(BMP_CAL_B1, &bmp->b1);
-  // Suppression des anciennes lignes if (read16(...) != 0)
-  CHECK_CAL_READ(BMP_CAL_B2, &bmp->b2);
-
-  CHECK_CAL_READ(BMP_CAL_MB, &bmp->mb);
-  CHECK_CAL_READ(BMP_CAL_MC, &bmp->mc);
-  CHECK_CAL_READ(BMP_CAL_MD, &bmp->md);
-  #undef CHECK_CAL_READ
+  /* Charge les données de calibration depuis le cache, sinon les lit en une seule transaction (0xAA à 0xBF) */
+  uint8_t blob[BMP_CALIB_BLOB_SIZE];
+  uint8_t cached = 0;
+  if (storage != NULL && storage->load != NULL &&
+      storage->load(chipId, i2c_address_7bit, blob, BMP_CALIB_BLOB_SIZE, storage->ctx) == 0 &&
+      blob[0] == chipId && CRC8_Poly31(blob, BMP_CALIB_BLOB_SIZE - 1, 0xFF) == blob[BMP_CALIB_BLOB_SIZE - 1]) {
+    cached = 1;
+    DEBUG_PRINT("BMP_Init: Calibration loaded from cache.\r\n");
+  } else {
+    status = readBytes(bmp, BMP_CAL_AC1, &blob[1], BMP_CALIB_RAW_SIZE);
+    if (status != BMP_OK) {
+      bmp->lastError = BMP_ERR_CAL_READ;
+      return BMP_ERR_CAL_READ;
+    }
+    blob[0] = chipId;
+    blob[BMP_CALIB_BLOB_SIZE - 1] = CRC8_Poly31(blob, BMP_CALIB_BLOB_SIZE - 1, 0xFF);
+  }
+  parseCalibration(bmp, &blob[1]);
+
+  // Mémorise la calibration pour les prochains démarrages (un échec n'empêche pas l'initialisation)
+  if (!cached && storage != NULL && storage->store != NULL) {
+    if (storage->store(chipId, i2c_address_7bit, blob, BMP_CALIB_BLOB_SIZE, storage->ctx) != 0) {
+      DEBUG_PRINT("BMP_Init Warning: Calibration could not be stored.\r\n");
+    }
+  }
 
   DEBUG_PRINT("BMP_Init: Calibration data read successfully.\r\n");
   #ifdef DEBUG_VERBOSE // Optionnel: Afficher les coeffs de calibration si très verbeux
@@ -206,6 +236,45 @@ static int32_t computeB5(BMP_Handle_t *bmp, int32_t UT)
   return X1 + X2; // Retourne la somme de X1 et X2
 }
 
+// Durée de conversion de la pression en ms selon le mode d'oversampling
+static uint32_t pressureDelay(uint8_t oversampling)
+{
+  if (oversampling == BMP_ULTRALOWPOWER) // Vérifie le niveau de suréchantillonnage
+    return BMP_PRES_CONVERSION_DELAY_ULP;
+  else if (oversampling == BMP_STANDARD)
+    return BMP_PRES_CONVERSION_DELAY_STD;
+  else if (oversampling == BMP_HIGHRES)
+    return BMP_PRES_CONVERSION_DELAY_HR;
+  else
+    return BMP_PRES_CONVERSION_DELAY_UHR;
+}
+
+// Lit le résultat d'une conversion de température déjà terminée
+static BMP_Status_t fetchRawTemperature(BMP_Handle_t *bmp, int32_t *ut)
+{
+  uint16_t raw_temp;
+  BMP_Status_t status = read16(bmp, BMP_TEMPDATA, &raw_temp);
+  if (status != BMP_OK) return status; // Erreur I2C
+  *ut = raw_temp;
+  DEBUG_PRINT("fetchRawTemperature: Raw temperature = %ld\r\n", *ut);
+  return BMP_OK;
+}
+
+// Lit le résultat d'une conversion de pression déjà terminée (MSB, LSB, XLSB en une seule lecture)
+static BMP_Status_t fetchRawPressure(BMP_Handle_t *bmp, int32_t *up)
+{
+  uint8_t raw[3];
+
+  BMP_Status_t status = readBytes(bmp, BMP_PRESSUREDATA, raw, 3);
+  if (status != BMP_OK) return status;
+  DEBUG_PRINT("fetchRawPressure: Raw values read (0x%02X 0x%02X 0x%02X)\r\n", raw[0], raw[1], raw[2]);
+
+  *up = ((uint32_t)raw[0] << 16) | ((uint32_t)raw[1] << 8) | raw[2];
+  *up >>= (8 - bmp->oversampling); // Ajuste selon le niveau de suréchantillonnage
+  DEBUG_PRINT("fetchRawPressure: Raw pressure (adjusted) = %ld\r\n", *up);
+  return BMP_OK;
+}
+
 // Retourne BMP_OK en cas de succès. Met la valeur lue dans *ut
 static BMP_Status_t readRawTemperature(BMP_Handle_t *bmp, int32_t *ut) // Lit la température brute
 {
@@ -219,23 +288,13 @@ static BMP_Status_t readRawTemperature(BMP_Handle_t *bmp, int32_t *ut) // Lit la
   if (status != BMP_OK) return status; // Erreur I2C
   DEBUG_PRINT("readRawTemperature: Waiting %d ms for conversion...\r\n", BMP_TEMP_CONVERSION_DELAY);
   HAL_Delay(BMP_TEMP_CONVERSION_DELAY); // Attend la conversion
-  uint16_t raw_temp;
-  // Correction: Appel à read16 avec les bons arguments
-  DEBUG_PRINT("readRawTemperature: Reading raw temperature value...\r\n");
-  status = read16(bmp, BMP_TEMPDATA, &raw_temp);
-  if (status != BMP_OK) return status; // Erreur I2C
-  *ut = raw_temp;
-  DEBUG_PRINT("readRawTemperature: Raw temperature = %ld\r\n", *ut);
-  return BMP_OK; // Succès
+  return fetchRawTemperature(bmp, ut);
 }
 
 // Retourne BMP_OK en cas de succès. Met la valeur lue dans *up
 static BMP_Status_t readRawPressure(BMP_Handle_t *bmp, int32_t *up) // Lit la pression brute
 {
-  uint16_t raw_pres_h;
-  uint8_t  raw_pres_l;
   uint32_t delay_ms;
-  // Suppression de l'ancien appel write8 incorrect
 
   if (bmp == NULL || up == NULL) {
       DEBUG_PRINT("readRawPressure Error: NULL pointer\r\n");
@@ -246,34 +305,11 @@ static BMP_Status_t readRawPressure(BMP_Handle_t *bmp, int32_t *up) // Lit la pr
   BMP_Status_t status = write8(bmp, BMP_CONTROL, BMP_READPRESSURECMD + (bmp->oversampling << 6));
   if (status != BMP_OK) return status;
 
-  // Choix du délai en fonction du mode
-  if (bmp->oversampling == BMP_ULTRALOWPOWER) // Vérifie le niveau de suréchantillonnage
-    delay_ms = BMP_PRES_CONVERSION_DELAY_ULP;
-  else if (bmp->oversampling == BMP_STANDARD)
-    delay_ms = BMP_PRES_CONVERSION_DELAY_STD;
-  // Correction: Utilisation de bmp->oversampling
-  else if (bmp->oversampling == BMP_HIGHRES)
-    delay_ms = BMP_PRES_CONVERSION_DELAY_HR;
-  else
-    delay_ms = BMP_PRES_CONVERSION_DELAY_UHR;
-
+  delay_ms = pressureDelay(bmp->oversampling); // Choix du délai en fonction du mode
   DEBUG_PRINT("readRawPressure: Waiting %ld ms for conversion...\r\n", delay_ms);
   HAL_Delay(delay_ms);
 
-  DEBUG_PRINT("readRawPressure: Reading raw pressure value...\r\n");
-  status = read16(bmp, BMP_PRESSUREDATA, &raw_pres_h); // Lit les deux premiers octets de la pression
-  // Correction: Appel à read16 avec les bons arguments (déjà correct ici)
-  if (status != BMP_OK) return status;
-  status = read8(bmp, BMP_PRESSUREDATA + 2, &raw_pres_l); // Lit le troisième octet
-  // Correction: Appel à read8 avec les bons arguments (déjà correct ici)
-  if (status != BMP_OK) return status;
-  DEBUG_PRINT("readRawPressure: Raw values read (MSB=0x%04X, LSB=0x%02X)\r\n", raw_pres_h, raw_pres_l);
-
-  *up = ((uint32_t)raw_pres_h << 8) | raw_pres_l;
-  *up >>= (8 - bmp->oversampling); // Ajuste selon le niveau de suréchantillonnage
-  DEBUG_PRINT("readRawPressure: Raw pressure (adjusted) = %ld\r\n", *up);
-
-  return BMP_OK; // Succès
+  return fetchRawPressure(bmp, up);
 }
 
 // --- Fonctions de lecture publiques ---
@@ -451,6 +487,155 @@ BMP_Status_t BMP_readAll(BMP_Handle_t *bmp, float *temp_degC, int32_t *pressure_
     return BMP_OK; // Succès
 }
 
+// Moyenne de plusieurs conversions de pression brutes (UP) avant une seule compensation.
+// Une seule température est mesurée : B5 varie peu pendant la rafale.
+BMP_Status_t BMP_readAllAveraged(BMP_Handle_t *bmp, uint8_t samples, float *temp_degC, int32_t *pressure_Pa)
+{
+    if (bmp == NULL || temp_degC == NULL || pressure_Pa == NULL) {
+        DEBUG_PRINT("BMP_readAllAveraged Error: NULL pointer\r\n");
+        return BMP_ERR_NULL_PTR;
+    }
+    if (samples == 0) {
+        return BMP_ERR_INVALID_PARAM;
+    }
+
+    int32_t UT, UP, B5;
+    int32_t sum = 0; // UP < 2^19 : 255 échantillons tiennent sur 32 bits
+    BMP_Status_t status;
+
+    bmp->lastError = BMP_OK;
+    status = readRawTemperature(bmp, &UT);
+    if (status != BMP_OK) {
+        return status;
+    }
+    for (uint8_t i = 0; i < samples; i++) {
+        status = readRawPressure(bmp, &UP);
+        if (status != BMP_OK) {
+            DEBUG_PRINT("BMP_readAllAveraged Error: readRawPressure failed (%d)\r\n", status);
+            return status;
+        }
+        sum += UP;
+    }
+    UP = (sum + samples / 2) / samples; // Moyenne arrondie
+
+    B5 = computeB5(bmp, UT);
+    if (bmp->lastError != BMP_OK) {
+        return bmp->lastError;
+    }
+    *temp_degC = (float)((B5 + 8) >> 4) / 10.0f;
+    *pressure_Pa = calculatePressure(bmp, UP, B5);
+    if (bmp->lastError != BMP_OK) {
+        return bmp->lastError;
+    }
+    DEBUG_PRINT("BMP_readAllAveraged: %d samples -> T=%.2f C P=%ld Pa\r\n", samples, *temp_degC, *pressure_Pa);
+    return BMP_OK;
+}
+
+// --- Conversions non bloquantes ---
+
+// Lance la conversion suivante : température si B5 est absent ou trop ancien, pression sinon
+static BMP_Status_t pipelineLaunch(BMP_Handle_t *bmp)
+{
+  BMP_Status_t status;
+
+  if (!bmp->b5Valid || bmp->presSinceTemp >= bmp->tempEvery) {
+    status = write8(bmp, BMP_CONTROL, BMP_READTEMPCMD);
+    bmp->pipeState = BMP_PIPE_TEMP;
+    bmp->pipeDelay = BMP_TEMP_CONVERSION_DELAY;
+  } else {
+    status = write8(bmp, BMP_CONTROL, BMP_READPRESSURECMD + (bmp->oversampling << 6));
+    bmp->pipeState = BMP_PIPE_PRES;
+    bmp->pipeDelay = pressureDelay(bmp->oversampling);
+  }
+  if (status != BMP_OK) {
+    bmp->pipeState = BMP_PIPE_IDLE;
+    return status;
+  }
+  bmp->pipeStart = HAL_GetTick();
+  return BMP_OK;
+}
+
+// Démarre les conversions non bloquantes. La valeur B5 issue d'une température est réutilisée
+// pour temp_every mesures de pression (1 = une température avant chaque pression, comme BMP_readAll).
+BMP_Status_t BMP_PipelineStart(BMP_Handle_t *bmp, uint8_t temp_every)
+{
+  if (bmp == NULL || bmp->i2cHandle == NULL) {
+      return BMP_ERR_NULL_PTR;
+  }
+  bmp->tempEvery = (temp_every == 0) ? 1 : temp_every;
+  bmp->presSinceTemp = 0;
+  bmp->b5Valid = 0;
+  return pipelineLaunch(bmp);
+}
+
+void BMP_PipelineStop(BMP_Handle_t *bmp)
+{
+  if (bmp != NULL) {
+    bmp->pipeState = BMP_PIPE_IDLE;
+  }
+}
+
+// Fait avancer la machine d'états sans jamais attendre. Retourne BMP_BUSY tant qu'aucune nouvelle
+// pression n'est disponible, BMP_OK quand *temp_degC et *pressure_Pa ont été mis à jour.
+// La conversion suivante est relancée aussitôt après chaque lecture.
+BMP_Status_t BMP_PipelineProcess(BMP_Handle_t *bmp, float *temp_degC, int32_t *pressure_Pa)
+{
+  BMP_Status_t status;
+  int32_t raw, p;
+
+  if (bmp == NULL || temp_degC == NULL || pressure_Pa == NULL) {
+      return BMP_ERR_NULL_PTR;
+  }
+  if (bmp->pipeState == BMP_PIPE_IDLE) {
+      // Arrêté ou erreur précédente : relance la séquence
+      status = pipelineLaunch(bmp);
+      return (status != BMP_OK) ? status : BMP_BUSY;
+  }
+  // "> délai" garantit au moins pipeDelay ms entières malgré la granularité de HAL_GetTick
+  if ((uint32_t)(HAL_GetTick() - bmp->pipeStart) <= bmp->pipeDelay) {
+      return BMP_BUSY;
+  }
+
+  if (bmp->pipeState == BMP_PIPE_TEMP) {
+      status = fetchRawTemperature(bmp, &raw);
+      if (status != BMP_OK) {
+          bmp->pipeState = BMP_PIPE_IDLE;
+          return status;
+      }
+      bmp->lastError = BMP_OK;
+      bmp->b5 = computeB5(bmp, raw);
+      if (bmp->lastError != BMP_OK) {
+          bmp->pipeState = BMP_PIPE_IDLE;
+          return bmp->lastError;
+      }
+      bmp->b5Valid = 1;
+      bmp->presSinceTemp = 0;
+      status = pipelineLaunch(bmp); // Enchaîne directement sur la pression
+      return (status != BMP_OK) ? status : BMP_BUSY;
+  }
+
+  status = fetchRawPressure(bmp, &raw);
+  if (status != BMP_OK) {
+      bmp->pipeState = BMP_PIPE_IDLE;
+      return status;
+  }
+  bmp->lastError = BMP_OK;
+  p = calculatePressure(bmp, raw, bmp->b5);
+  if (bmp->lastError != BMP_OK) {
+      bmp->pipeState = BMP_PIPE_IDLE;
+      return bmp->lastError;
+  }
+  bmp->presSinceTemp++;
+
+  // Conversion suivante pendant que l'application traite la mesure. En cas d'échec, la mesure reste
+  // valide : l'état repasse à BMP_PIPE_IDLE et l'appel suivant relance la séquence.
+  (void)pipelineLaunch(bmp);
+  *temp_degC = (float)((bmp->b5 + 8) >> 4) / 10.0f;
+  *pressure_Pa = p;
+  DEBUG_PRINT("BMP_PipelineProcess: T=%.2f C P=%ld Pa\r\n", *temp_degC, *pressure_Pa);
+  return BMP_OK;
+}
+
 // --- Fonctions de calcul publiques (ne dépendent pas directement du handle) ---
 
 // Calcule l'altitude en mètres. Retourne BMP_OK ou BMP_ERR_INVALID_PARAM.
@@ -487,3 +672,132 @@ int32_t BMP_calculateSealevelPressure(int32_t pressure_Pa, float altitude_m) //
   DEBUG_PRINT("BMP_calculateSealevelPressure: P=%ld Pa, Alt=%.1f m -> P0=%ld Pa\r\n", pressure_Pa, altitude_m, sealevel_p);
   return sealevel_p; // Calcule la pression au niveau de la mer
 } // Correction: Ajout de l'accolade fermante manquante
+
+// --- Formule barométrique sans powf ---
+
+// log2(x) pour x > 0 (normal) : exposant IEEE-754 + série atanh sur la mantisse ramenée dans [0.707, 1.414[
+static float fastLog2(float x)
+{
+  union { float f; uint32_t u; } v = { x };
+  int32_t e = (int32_t)((v.u >> 23) & 0xFF) - 127;
+  v.u = (v.u & 0x007FFFFFu) | 0x3F800000u; // Mantisse dans [1, 2[
+  if (v.f > 1.41421356f) {
+    v.f *= 0.5f;
+    e++;
+  }
+  float s = (v.f - 1.0f) / (v.f + 1.0f);
+  float s2 = s * s;
+  // ln(m) = 2 (s + s^3/3 + s^5/5 + s^7/7), erreur < 3e-8 ; 2/ln(2) = 2.88539008
+  float ln = s * (1.0f + s2 * (0.33333333f + s2 * (0.2f + s2 * 0.14285714f)));
+  return (float)e + 2.88539008f * ln;
+}
+
+// 2^x : partie entière dans l'exposant, Taylor de degré 6 de e^(f ln2) pour f dans [-0.5, 0.5] (erreur < 2e-7)
+static float fastExp2(float x)
+{
+  union { float f; uint32_t u; } scale;
+
+  if (x > 127.0f) x = 127.0f;
+  if (x < -126.0f) return 0.0f;
+
+  int32_t n = (int32_t)(x + (x >= 0.0f ? 0.5f : -0.5f)); // Arrondi au plus proche
+  float t = (x - (float)n) * 0.69314718f;
+  float p = 1.0f + t * (1.0f + t * (0.5f + t * (0.16666667f + t * (0.041666668f + t * (0.0083333338f + t * 0.0013888889f)))));
+  scale.u = (uint32_t)(n + 127) << 23;
+  return p * scale.f;
+}
+
+// Altitude à partir de log2(P) - log2(P0) : 44330 * (1 - (P/P0)^0.1903)
+static float altitudeFromLog2Ratio(float log2_ratio)
+{
+  return 44330.0f * (1.0f - fastExp2(0.1903f * log2_ratio));
+}
+
+BMP_Status_t BMP_calculateAltitudeFast(int32_t pressure_Pa, float sealevelPressure_Pa, float *altitude_m)
+{
+  if (altitude_m == NULL) {
+      return BMP_ERR_NULL_PTR;
+  }
+  if (pressure_Pa <= 0 || sealevelPressure_Pa <= 0) {
+      *altitude_m = NAN;
+      return BMP_ERR_INVALID_PARAM;
+  }
+  *altitude_m = altitudeFromLog2Ratio(fastLog2((float)pressure_Pa) - fastLog2(sealevelPressure_Pa));
+  return BMP_OK;
+}
+
+int32_t BMP_calculateSealevelPressureFast(int32_t pressure_Pa, float altitude_m)
+{
+  float base = 1.0f - altitude_m / 44330.0f;
+  if (base <= 0) {
+      DEBUG_PRINT("BMP_calculateSealevelPressureFast Error: Calculation factor <= 0 (Alt=%.1f m)\r\n", altitude_m);
+      return 0;
+  }
+  // P / base^5.255 = P * 2^(-5.255 log2(base)) : pas de division
+  return (int32_t)((float)pressure_Pa * fastExp2(-5.255f * fastLog2(base)));
+}
+
+BMP_Status_t BMP_calculateAltitudeArray(const int32_t *pressure_Pa, float *altitude_m, uint16_t count,
+                                        float sealevelPressure_Pa)
+{
+  BMP_Status_t status = BMP_OK;
+
+  if (pressure_Pa == NULL || altitude_m == NULL) {
+      return BMP_ERR_NULL_PTR;
+  }
+  if (sealevelPressure_Pa <= 0) {
+      return BMP_ERR_INVALID_PARAM;
+  }
+
+  float log2_p0 = fastLog2(sealevelPressure_Pa);
+  for (uint16_t i = 0; i < count; i++) {
+    if (pressure_Pa[i] <= 0) {
+      altitude_m[i] = NAN;
+      status = BMP_ERR_INVALID_PARAM; // Les autres échantillons sont tout de même convertis
+      continue;
+    }
+    altitude_m[i] = altitudeFromLog2Ratio(fastLog2((float)pressure_Pa[i]) - log2_p0);
+  }
+  return status;
+}
+
+#ifdef BMP_ALT_BENCHMARK
+void BMP_benchmarkAltitude(uint32_t samples, uint32_t *ref_cycles, uint32_t *fast_cycles, float *max_error_m)
+{
+  volatile float sink = 0.0f; // Empêche le compilateur d'éliminer les boucles
+  float ref, fast, err, max_err = 0.0f;
+  uint32_t start, ref_ms, fast_ms;
+
+  if (samples == 0) {
+    return;
+  }
+
+  // Pressions réparties sur 300..1100 hPa
+  start = HAL_GetTick();
+  for (uint32_t n = 0; n < samples; n++) {
+    BMP_calculateAltitude(30000 + (int32_t)(n % 80001u), 101325.0f, &ref);
+    sink += ref;
+  }
+  ref_ms = HAL_GetTick() - start;
+
+  start = HAL_GetTick();
+  for (uint32_t n = 0; n < samples; n++) {
+    BMP_calculateAltitudeFast(30000 + (int32_t)(n % 80001u), 101325.0f, &fast);
+    sink += fast;
+  }
+  fast_ms = HAL_GetTick() - start;
+  (void)sink;
+
+  // Écart maximal, hors chronométrage
+  for (int32_t p = 30000; p <= 110000; p += 7) {
+    BMP_calculateAltitude(p, 101325.0f, &ref);
+    BMP_calculateAltitudeFast(p, 101325.0f, &fast);
+    err = fabsf(fast - ref);
+    if (err > max_err) max_err = err;
+  }
+
+  if (ref_cycles != NULL) *ref_cycles = (uint32_t)(((uint64_t)ref_ms * (SystemCoreClock / 1000u)) / samples);
+  if (fast_cycles != NULL) *fast_cycles = (uint32_t)(((uint64_t)fast_ms * (SystemCoreClock / 1000u)) / samples);
+  if (max_error_m != NULL) *max_error_m = max_err;
+}
+#endif
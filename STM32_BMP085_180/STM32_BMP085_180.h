@@ -9,6 +9,7 @@
 #include "stm32l0xx_hal.h" // Remplacez stm32l0xx_hal.h si vous utilisez une autre série de carte ex : stm32f4xx_hal.h.
 
 // #define DEBUG_ON
+// #define BMP_ALT_BENCHMARK // Décommenter pour compiler BMP_benchmarkAltitude
 
 // Modes
 #define BMP_ULTRALOWPOWER 0 //!< Mode ultra basse consommation
@@ -28,9 +29,32 @@ typedef enum
   BMP_ERR_CAL_READ = 4,      //!< Erreur lors de la lecture des données de calibration
   BMP_ERR_NULL_PTR = 5,      //!< Pointeur NULL fourni en argument
   BMP_ERR_INVALID_PARAM = 6, //!< Paramètre invalide fourni (ex: mode, pression/altitude négative)
-  BMP_ERR_MATH = 7           //!< Erreur de calcul interne (ex: division par zéro)
+  BMP_ERR_MATH = 7,          //!< Erreur de calcul interne (ex: division par zéro)
+  BMP_BUSY = 8               //!< Conversion en cours, pas encore de nouvelle mesure (mode non bloquant)
 } BMP_Status_t;
 
+// États de la machine de conversion non bloquante
+typedef enum
+{
+  BMP_PIPE_IDLE = 0, //!< Aucune conversion en cours
+  BMP_PIPE_TEMP,     //!< Conversion de température en cours
+  BMP_PIPE_PRES      //!< Conversion de pression en cours
+} BMP_PipeState_t;
+
+#define BMP_CALIB_RAW_SIZE 22                        //!< Bloc de calibration 0xAA à 0xBF
+#define BMP_CALIB_BLOB_SIZE (BMP_CALIB_RAW_SIZE + 2) //!< ID de puce + bloc brut + CRC8 (STM32_CRC8)
+
+// Sauvegarde de la calibration BMP085/BMP180 : le blob contient l'ID 0x55, les 11 coefficients
+// AC1..MD (22 octets, 0xAA à 0xBF, gros-boutiste tels que lus) et un CRC8. Les deux modèles partagent
+// l'ID 0x55 et l'adresse 0x77 : le cache désigne un emplacement, pas un exemplaire, il faut donc
+// l'effacer après remplacement du capteur.
+typedef struct
+{
+  int8_t (*load)(uint8_t chip_id, uint8_t i2c_address_7bit, uint8_t *blob, uint16_t len, void *ctx);        //!< Retourne 0 si un blob a été chargé
+  int8_t (*store)(uint8_t chip_id, uint8_t i2c_address_7bit, const uint8_t *blob, uint16_t len, void *ctx); //!< Retourne 0 si succès (peut être NULL)
+  void *ctx;                                                                                                  //!< Pointeur utilisateur transmis aux callbacks
+} BMP_CalibStorage_t;
+
 // Structure pour contenir les informations d'instance du capteur
 typedef struct
 {
@@ -45,15 +69,45 @@ typedef struct
   int16_t mb, mc, md;
 
   BMP_Status_t lastError; //!< Stocke la dernière erreur rencontrée (optionnel)
+
+  // Machine de conversion non bloquante (BMP_PipelineStart / BMP_PipelineProcess)
+  BMP_PipeState_t pipeState; //!< Conversion en cours
+  uint32_t pipeStart;        //!< HAL_GetTick() au lancement de la conversion
+  uint32_t pipeDelay;        //!< Durée de la conversion en cours en ms
+  int32_t b5;                //!< Dernière valeur B5 (température compensée)
+  uint8_t b5Valid;           //!< 1 si b5 est utilisable
+  uint8_t tempEvery;         //!< Nombre de mesures de pression par mesure de température
+  uint8_t presSinceTemp;     //!< Mesures de pression depuis la dernière température
 } BMP_Handle_t;
 
 // Déclaration des fonctions pour interagir avec le capteur BMP085/BMP180
 BMP_Status_t BMP_Init(BMP_Handle_t *bmp, uint8_t mode, I2C_HandleTypeDef *i2cdev, uint8_t i2c_address_7bit); // Initialise le capteur BMP.
+BMP_Status_t BMP_InitWithStorage(BMP_Handle_t *bmp, uint8_t mode, I2C_HandleTypeDef *i2cdev, uint8_t i2c_address_7bit,
+                                 const BMP_CalibStorage_t *storage);                                         // Initialise le capteur en utilisant un cache de calibration (storage peut être NULL).
 BMP_Status_t BMP_Init_Default(BMP_Handle_t *bmp, I2C_HandleTypeDef *i2cdev, uint8_t i2c_address_7bit);       // Initialise le capteur BMP avec le mode par défaut.
 BMP_Status_t BMP_readTemperature(BMP_Handle_t *bmp, float *temp_degC);                                       // Lit la température.
 BMP_Status_t BMP_readPressure(BMP_Handle_t *bmp, int32_t *pressure_Pa);                                      // Lit la pression.
 BMP_Status_t BMP_readAll(BMP_Handle_t *bmp, float *temp_degC, int32_t *pressure_Pa);                         // Lit température et pression efficacement.
+BMP_Status_t BMP_readAllAveraged(BMP_Handle_t *bmp, uint8_t samples, float *temp_degC, int32_t *pressure_Pa); // Moyenne de samples pressions brutes, compensée une seule fois (bloquant).
+BMP_Status_t BMP_PipelineStart(BMP_Handle_t *bmp, uint8_t temp_every);                                     // Lance les conversions non bloquantes (température toutes les temp_every pressions).
+BMP_Status_t BMP_PipelineProcess(BMP_Handle_t *bmp, float *temp_degC, int32_t *pressure_Pa);                 // À appeler en boucle : BMP_OK si nouvelle mesure, BMP_BUSY sinon.
+void BMP_PipelineStop(BMP_Handle_t *bmp);                                                                    // Arrête les conversions non bloquantes.
 BMP_Status_t BMP_calculateAltitude(int32_t pressure_Pa, float sealevelPressure_Pa, float *altitude_m);       // Calcule l'altitude à partir de la pression mesurée.
 int32_t BMP_calculateSealevelPressure(int32_t pressure_Pa, float altitude_m);                                // Calcule la pression au niveau de la mer. Retourne 0 en cas d'erreur.
 
+// Variantes rapides sans powf (log2/exp2 polynomiaux, aucune fonction de libm).
+// Écart avec la formule exacte : < 0,02 m en altitude et < 2 Pa au niveau de la mer (troncature entière comprise)
+// pour 300 à 1100 hPa et une pression de référence de 950 à 1050 hPa.
+BMP_Status_t BMP_calculateAltitudeFast(int32_t pressure_Pa, float sealevelPressure_Pa, float *altitude_m);   // Comme BMP_calculateAltitude, sans powf.
+int32_t BMP_calculateSealevelPressureFast(int32_t pressure_Pa, float altitude_m);                            // Comme BMP_calculateSealevelPressure, sans powf.
+BMP_Status_t BMP_calculateAltitudeArray(const int32_t *pressure_Pa, float *altitude_m, uint16_t count,
+                                        float sealevelPressure_Pa);                                          // Convertit un tableau de pressions (log2(P0) calculé une seule fois). NAN pour une pression <= 0.
+
+#ifdef BMP_ALT_BENCHMARK
+// Compare BMP_calculateAltitudeFast à BMP_calculateAltitude sur 300..1100 hPa (P0 = 1013,25 hPa) :
+// coût moyen en cycles CPU par conversion (chronométré avec HAL_GetTick, utiliser au moins 10000 échantillons)
+// et écart maximal en mètres. Aucun accès I2C.
+void BMP_benchmarkAltitude(uint32_t samples, uint32_t *ref_cycles, uint32_t *fast_cycles, float *max_error_m);
+#endif
+
 #endif // Fin de la protection contre les inclusions multiples
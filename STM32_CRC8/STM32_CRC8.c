@@ -0,0 +1,179 @@
+#include "STM32_CRC8.h"
+
+#ifdef CRC8_BENCHMARK
+#include "stm32l0xx_hal.h" // Remplacez stm32l0xx_hal.h si vous utilisez une autre série de carte ex : stm32f4xx_hal.h.
+#endif
+
+#if defined(CRC8_USE_TABLE256)
+// crc = table[crc ^ octet] : CRC des 256 valeurs d'octet
+static const uint8_t crc8_poly31_table[256] = {
+    0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97, 0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F, 0x2E,
+    0x43, 0x72, 0x21, 0x10, 0x87, 0xB6, 0xE5, 0xD4, 0xFA, 0xCB, 0x98, 0xA9, 0x3E, 0x0F, 0x5C, 0x6D,
+    0x86, 0xB7, 0xE4, 0xD5, 0x42, 0x73, 0x20, 0x11, 0x3F, 0x0E, 0x5D, 0x6C, 0xFB, 0xCA, 0x99, 0xA8,
+    0xC5, 0xF4, 0xA7, 0x96, 0x01, 0x30, 0x63, 0x52, 0x7C, 0x4D, 0x1E, 0x2F, 0xB8, 0x89, 0xDA, 0xEB,
+    0x3D, 0x0C, 0x5F, 0x6E, 0xF9, 0xC8, 0x9B, 0xAA, 0x84, 0xB5, 0xE6, 0xD7, 0x40, 0x71, 0x22, 0x13,
+    0x7E, 0x4F, 0x1C, 0x2D, 0xBA, 0x8B, 0xD8, 0xE9, 0xC7, 0xF6, 0xA5, 0x94, 0x03, 0x32, 0x61, 0x50,
+    0xBB, 0x8A, 0xD9, 0xE8, 0x7F, 0x4E, 0x1D, 0x2C, 0x02, 0x33, 0x60, 0x51, 0xC6, 0xF7, 0xA4, 0x95,
+    0xF8, 0xC9, 0x9A, 0xAB, 0x3C, 0x0D, 0x5E, 0x6F, 0x41, 0x70, 0x23, 0x12, 0x85, 0xB4, 0xE7, 0xD6,
+    0x7A, 0x4B, 0x18, 0x29, 0xBE, 0x8F, 0xDC, 0xED, 0xC3, 0xF2, 0xA1, 0x90, 0x07, 0x36, 0x65, 0x54,
+    0x39, 0x08, 0x5B, 0x6A, 0xFD, 0xCC, 0x9F, 0xAE, 0x80, 0xB1, 0xE2, 0xD3, 0x44, 0x75, 0x26, 0x17,
+    0xFC, 0xCD, 0x9E, 0xAF, 0x38, 0x09, 0x5A, 0x6B, 0x45, 0x74, 0x27, 0x16, 0x81, 0xB0, 0xE3, 0xD2,
+    0xBF, 0x8E, 0xDD, 0xEC, 0x7B, 0x4A, 0x19, 0x28, 0x06, 0x37, 0x64, 0x55, 0xC2, 0xF3, 0xA0, 0x91,
+    0x47, 0x76, 0x25, 0x14, 0x83, 0xB2, 0xE1, 0xD0, 0xFE, 0xCF, 0x9C, 0xAD, 0x3A, 0x0B, 0x58, 0x69,
+    0x04, 0x35, 0x66, 0x57, 0xC0, 0xF1, 0xA2, 0x93, 0xBD, 0x8C, 0xDF, 0xEE, 0x79, 0x48, 0x1B, 0x2A,
+    0xC1, 0xF0, 0xA3, 0x92, 0x05, 0x34, 0x67, 0x56, 0x78, 0x49, 0x1A, 0x2B, 0xBC, 0x8D, 0xDE, 0xEF,
+    0x82, 0xB3, 0xE0, 0xD1, 0x46, 0x77, 0x24, 0x15, 0x3B, 0x0A, 0x59, 0x68, 0xFF, 0xCE, 0x9D, 0xAC,
+};
+static const uint8_t crc8_maxim_table[256] = {
+    0x00, 0x5E, 0xBC, 0xE2, 0x61, 0x3F, 0xDD, 0x83, 0xC2, 0x9C, 0x7E, 0x20, 0xA3, 0xFD, 0x1F, 0x41,
+    0x9D, 0xC3, 0x21, 0x7F, 0xFC, 0xA2, 0x40, 0x1E, 0x5F, 0x01, 0xE3, 0xBD, 0x3E, 0x60, 0x82, 0xDC,
+    0x23, 0x7D, 0x9F, 0xC1, 0x42, 0x1C, 0xFE, 0xA0, 0xE1, 0xBF, 0x5D, 0x03, 0x80, 0xDE, 0x3C, 0x62,
+    0xBE, 0xE0, 0x02, 0x5C, 0xDF, 0x81, 0x63, 0x3D, 0x7C, 0x22, 0xC0, 0x9E, 0x1D, 0x43, 0xA1, 0xFF,
+    0x46, 0x18, 0xFA, 0xA4, 0x27, 0x79, 0x9B, 0xC5, 0x84, 0xDA, 0x38, 0x66, 0xE5, 0xBB, 0x59, 0x07,
+    0xDB, 0x85, 0x67, 0x39, 0xBA, 0xE4, 0x06, 0x58, 0x19, 0x47, 0xA5, 0xFB, 0x78, 0x26, 0xC4, 0x9A,
+    0x65, 0x3B, 0xD9, 0x87, 0x04, 0x5A, 0xB8, 0xE6, 0xA7, 0xF9, 0x1B, 0x45, 0xC6, 0x98, 0x7A, 0x24,
+    0xF8, 0xA6, 0x44, 0x1A, 0x99, 0xC7, 0x25, 0x7B, 0x3A, 0x64, 0x86, 0xD8, 0x5B, 0x05, 0xE7, 0xB9,
+    0x8C, 0xD2, 0x30, 0x6E, 0xED, 0xB3, 0x51, 0x0F, 0x4E, 0x10, 0xF2, 0xAC, 0x2F, 0x71, 0x93, 0xCD,
+    0x11, 0x4F, 0xAD, 0xF3, 0x70, 0x2E, 0xCC, 0x92, 0xD3, 0x8D, 0x6F, 0x31, 0xB2, 0xEC, 0x0E, 0x50,
+    0xAF, 0xF1, 0x13, 0x4D, 0xCE, 0x90, 0x72, 0x2C, 0x6D, 0x33, 0xD1, 0x8F, 0x0C, 0x52, 0xB0, 0xEE,
+    0x32, 0x6C, 0x8E, 0xD0, 0x53, 0x0D, 0xEF, 0xB1, 0xF0, 0xAE, 0x4C, 0x12, 0x91, 0xCF, 0x2D, 0x73,
+    0xCA, 0x94, 0x76, 0x28, 0xAB, 0xF5, 0x17, 0x49, 0x08, 0x56, 0xB4, 0xEA, 0x69, 0x37, 0xD5, 0x8B,
+    0x57, 0x09, 0xEB, 0xB5, 0x36, 0x68, 0x8A, 0xD4, 0x95, 0xCB, 0x29, 0x77, 0xF4, 0xAA, 0x48, 0x16,
+    0xE9, 0xB7, 0x55, 0x0B, 0x88, 0xD6, 0x34, 0x6A, 0x2B, 0x75, 0x97, 0xC9, 0x4A, 0x14, 0xF6, 0xA8,
+    0x74, 0x2A, 0xC8, 0x96, 0x15, 0x4B, 0xA9, 0xF7, 0xB6, 0xE8, 0x0A, 0x54, 0xD7, 0x89, 0x6B, 0x35,
+};
+#elif defined(CRC8_USE_NIBBLE)
+// Même principe par quartet : deux consultations par octet
+static const uint8_t crc8_poly31_nibble[16] = {
+    0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97, 0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F, 0x2E,
+};
+static const uint8_t crc8_maxim_nibble[16] = {
+    0x00, 0x9D, 0x23, 0xBE, 0x46, 0xDB, 0x65, 0xF8, 0x8C, 0x11, 0xAF, 0x32, 0xCA, 0x57, 0xE9, 0x74,
+};
+#endif
+
+uint8_t CRC8_Poly31_Bitwise(const uint8_t *data, uint16_t len, uint8_t init)
+{
+    uint8_t crc = init;
+    for (uint16_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t j = 0; j < 8; j++) {
+            if (crc & 0x80) {
+                crc = (crc << 1) ^ 0x31; // Polynôme 0x31
+            } else {
+                crc <<= 1;
+            }
+        }
+    }
+    return crc;
+}
+
+uint8_t CRC8_Maxim_Bitwise(const uint8_t *data, uint16_t len)
+{
+    uint8_t crc = 0;
+    for (uint16_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t j = 0; j < 8; j++) {
+            if (crc & 0x01) {
+                crc = (crc >> 1) ^ 0x8C; // Polynôme 0x31 réfléchi
+            } else {
+                crc >>= 1;
+            }
+        }
+    }
+    return crc;
+}
+
+uint8_t CRC8_Poly31(const uint8_t *data, uint16_t len, uint8_t init)
+{
+#if defined(CRC8_USE_TABLE256)
+    uint8_t crc = init;
+    while (len--) {
+        crc = crc8_poly31_table[crc ^ *data++];
+    }
+    return crc;
+#elif defined(CRC8_USE_NIBBLE)
+    uint8_t crc = init;
+    while (len--) {
+        crc ^= *data++;
+        crc = (uint8_t)(crc << 4) ^ crc8_poly31_nibble[crc >> 4];
+        crc = (uint8_t)(crc << 4) ^ crc8_poly31_nibble[crc >> 4];
+    }
+    return crc;
+#else
+    return CRC8_Poly31_Bitwise(data, len, init);
+#endif
+}
+
+uint8_t CRC8_Maxim(const uint8_t *data, uint16_t len)
+{
+#if defined(CRC8_USE_TABLE256)
+    uint8_t crc = 0;
+    while (len--) {
+        crc = crc8_maxim_table[crc ^ *data++];
+    }
+    return crc;
+#elif defined(CRC8_USE_NIBBLE)
+    uint8_t crc = 0;
+    while (len--) {
+        crc ^= *data++;
+        crc = (crc >> 4) ^ crc8_maxim_nibble[crc & 0x0F];
+        crc = (crc >> 4) ^ crc8_maxim_nibble[crc & 0x0F];
+    }
+    return crc;
+#else
+    return CRC8_Maxim_Bitwise(data, len);
+#endif
+}
+
+#ifdef CRC8_BENCHMARK
+// Convertit une durée en cycles par octet
+static uint32_t crc8_cycles(uint32_t elapsed_ms, uint32_t bytes)
+{
+    return (uint32_t)(((uint64_t)elapsed_ms * (SystemCoreClock / 1000u)) / bytes);
+}
+
+uint8_t CRC8_Benchmark(uint32_t bytes, uint32_t poly31[2], uint32_t maxim[2])
+{
+    uint8_t buf[64];
+    uint32_t lcg = 12345u; // Générateur pseudo-aléatoire
+    uint32_t blocks, start, t[4];
+    uint8_t fast31 = 0, slow31 = 0, fastMx = 0, slowMx = 0;
+
+    for (uint8_t i = 0; i < sizeof(buf); i++) {
+        lcg = lcg * 1664525u + 1013904223u;
+        buf[i] = (uint8_t)(lcg >> 24);
+    }
+    blocks = bytes / sizeof(buf);
+    if (blocks == 0) {
+        return 0;
+    }
+
+    // Le CRC de chaque bloc sert de valeur initiale au suivant : la boucle ne peut pas être éliminée
+    start = HAL_GetTick();
+    for (uint32_t n = 0; n < blocks; n++) fast31 = CRC8_Poly31(buf, sizeof(buf), fast31);
+    t[0] = HAL_GetTick() - start;
+    start = HAL_GetTick();
+    for (uint32_t n = 0; n < blocks; n++) slow31 = CRC8_Poly31_Bitwise(buf, sizeof(buf), slow31);
+    t[1] = HAL_GetTick() - start;
+    uint8_t first = buf[0]; // Dallas/Maxim n'a pas de valeur initiale : le CRC est réinjecté dans le premier octet
+    start = HAL_GetTick();
+    for (uint32_t n = 0; n < blocks; n++) { buf[0] ^= fastMx; fastMx = CRC8_Maxim(buf, sizeof(buf)); buf[0] ^= fastMx; }
+    t[2] = HAL_GetTick() - start;
+    buf[0] = first;
+    start = HAL_GetTick();
+    for (uint32_t n = 0; n < blocks; n++) { buf[0] ^= slowMx; slowMx = CRC8_Maxim_Bitwise(buf, sizeof(buf)); buf[0] ^= slowMx; }
+    t[3] = HAL_GetTick() - start;
+
+    bytes = blocks * sizeof(buf);
+    if (poly31 != NULL) {
+        poly31[0] = crc8_cycles(t[0], bytes);
+        poly31[1] = crc8_cycles(t[1], bytes);
+    }
+    if (maxim != NULL) {
+        maxim[0] = crc8_cycles(t[2], bytes);
+        maxim[1] = crc8_cycles(t[3], bytes);
+    }
+    return (fast31 == slow31) && (fastMx == slowMx);
+}
+#endif
@@ -0,0 +1,57 @@
+#ifndef STM32_CRC8_H
+#define STM32_CRC8_H
+
+// CRC8 partagé par les drivers de capteurs :
+//  - polynôme 0x31 (x^8 + x^5 + x^4 + 1), MSB en premier : AHT20, DHT20 (valeur initiale 0xFF) ;
+//  - Dallas/Maxim (même polynôme réfléchi, 0x8C), LSB en premier, valeur initiale 0 : 1-Wire / DS18B20.
+
+#include <stdint.h>
+
+// Choix de l'implémentation selon la place disponible en flash (une seule, par défaut CRC8_USE_TABLE256) :
+// #define CRC8_USE_TABLE256 // 2 tables de 256 octets (512 octets de flash), 1 lecture de table par octet
+// #define CRC8_USE_NIBBLE   // 2 tables de 16 octets (32 octets de flash), 2 lectures de table par octet
+// #define CRC8_USE_BITWISE  // Aucune table, 8 itérations par octet
+#if !defined(CRC8_USE_TABLE256) && !defined(CRC8_USE_NIBBLE) && !defined(CRC8_USE_BITWISE)
+#define CRC8_USE_TABLE256
+#endif
+
+// #define CRC8_BENCHMARK // Décommenter pour compiler CRC8_Benchmark
+
+/**
+ * @brief CRC8 polynôme 0x31, MSB en premier (AHT20, DHT20 : init = 0xFF).
+ * @param data Octets à contrôler.
+ * @param len Nombre d'octets.
+ * @param init Valeur initiale du CRC.
+ * @return CRC calculé.
+ */
+uint8_t CRC8_Poly31(const uint8_t *data, uint16_t len, uint8_t init);
+
+/**
+ * @brief CRC8 Dallas/Maxim (1-Wire), LSB en premier, valeur initiale 0.
+ *        Le CRC d'une ROM ou d'un scratchpad complet (CRC inclus) vaut 0.
+ * @param data Octets à contrôler.
+ * @param len Nombre d'octets.
+ * @return CRC calculé.
+ */
+uint8_t CRC8_Maxim(const uint8_t *data, uint16_t len);
+
+/**
+ * @brief Versions bit à bit (8 itérations par octet), référence de CRC8_Benchmark et de CRC8_USE_BITWISE.
+ */
+uint8_t CRC8_Poly31_Bitwise(const uint8_t *data, uint16_t len, uint8_t init);
+uint8_t CRC8_Maxim_Bitwise(const uint8_t *data, uint16_t len);
+
+#ifdef CRC8_BENCHMARK
+/**
+ * @brief Mesure le coût moyen par octet (cycles CPU) de l'implémentation compilée et des boucles bit à bit.
+ *        Calcule `bytes` octets pour chaque variante et chronomètre avec HAL_GetTick() :
+ *        utiliser au moins 1000000 octets pour une résolution correcte. Vérifie aussi que les résultats concordent.
+ * @param bytes Nombre d'octets traités par variante.
+ * @param poly31 Reçoit {compilée, bit à bit} en cycles/octet pour le polynôme 0x31 (peut être NULL).
+ * @param maxim Reçoit {compilée, bit à bit} en cycles/octet pour Dallas/Maxim (peut être NULL).
+ * @return 1 si les deux implémentations donnent les mêmes CRC, 0 sinon.
+ */
+uint8_t CRC8_Benchmark(uint32_t bytes, uint32_t poly31[2], uint32_t maxim[2]);
+#endif
+
+#endif /* STM32_CRC8_H */
@@ -19,6 +19,16 @@
 #define DHT_RESPONSE_LOW_DURATION 80 ///< Durée attendue de la réponse basse
 #define DHT_BIT_DECISION_TIME 40 ///< Temps après lequel on décide si un bit est 0 ou 1
 
+// Moteur par capture d'entrée (durées en microsecondes sauf mention contraire)
+#define DHT_IC_BIT_THRESHOLD 48     ///< Niveau haut plus long -> bit '1' (0 : ~26 µs, 1 : ~70 µs)
+#define DHT_IC_RELEASE_MAX 60       ///< Relâchement -> réponse basse du capteur (20 à 40 µs)
+#define DHT_IC_PULSE_MAX 100        ///< Durée maximale d'une impulsion de la trame
+#define DHT_IC_START_LOW_MS_DHT11 19 ///< Impulsion de démarrage DHT11 (ms, > 18 ms)
+#define DHT_IC_START_LOW_MS_DHT22 2  ///< Impulsion de démarrage DHT22/21 (ms, > 1 ms)
+#define DHT_IC_TIMEOUT_MS 10        ///< Durée maximale de la trame après le relâchement (~5 ms)
+
+static HAL_StatusTypeDef DHT_Convert(DHT_Sensor* sensor, float data[2]);
+
 /**
  * @brief Initialise le capteur DHT
  *
@@ -208,6 +218,17 @@ static void microDelay(DHT_Sensor* sensor, uint16_t delay) {
         return status;
     }
 
+    return DHT_Convert(sensor, data);
+} // Fin DHT_GetData
+
+/**
+ * @brief Vérifie la somme de contrôle des octets bruts et les convertit en température et humidité
+ *
+ * @param sensor Pointeur vers la structure DHT_Sensor contenant les octets lus
+ * @param data Tableau pour stocker les données de température et d'humidité
+ * @return HAL_StatusTypeDef HAL_OK, ou HAL_ERROR si la somme de contrôle est fausse
+ */
+static HAL_StatusTypeDef DHT_Convert(DHT_Sensor* sensor, float data[2]) {
     sensor->CHECK = sensor->hum1 + sensor->hum2 + sensor->temp1 + sensor->temp2;
 
     if (sensor->CHECK != sensor->SUM) {
@@ -232,4 +253,251 @@ static void microDelay(DHT_Sensor* sensor, uint16_t delay) {
      }
 
     return HAL_OK;
-} // Fin DHT_GetData
+}
+
+// --- Moteur par capture d'entrée ---
+
+/**
+ * @brief Convertit un canal TIM_CHANNEL_x en canal actif HAL_TIM_ACTIVE_CHANNEL_x
+ */
+static uint32_t DHT_IC_ActiveChannel(uint32_t channel) {
+    switch (channel) {
+        case TIM_CHANNEL_1: return HAL_TIM_ACTIVE_CHANNEL_1;
+        case TIM_CHANNEL_2: return HAL_TIM_ACTIVE_CHANNEL_2;
+        case TIM_CHANNEL_3: return HAL_TIM_ACTIVE_CHANNEL_3;
+        default:            return HAL_TIM_ACTIVE_CHANNEL_4;
+    }
+}
+
+/**
+ * @brief Décode les 40 bits à partir des horodatages des fronts
+ *
+ * Les fronts sont : [relâchement], réponse basse, réponse haute, début du premier bit,
+ * puis pour chaque bit un front montant et un front descendant. Le front de relâchement
+ * n'est capturé que si la ligne remonte après le passage en capture : il est reconnu à sa
+ * durée courte (20 à 40 µs avant la réponse du capteur). Le timer 16 bits peut déborder
+ * pendant la trame : les durées sont calculées modulo 2^16.
+ *
+ * @param h Contexte de capture (edges rempli)
+ * @return HAL_OK si la trame est cohérente, HAL_ERROR sinon
+ */
+static HAL_StatusTypeDef DHT_IC_Decode(DHT_IC_Handle* h) {
+    const uint16_t* e = h->edges;
+    uint8_t bytes[5] = {0};
+    uint8_t first = ((uint16_t)(e[1] - e[0]) < DHT_IC_RELEASE_MAX) ? 4 : 3; // Premier front montant d'un bit
+
+    for (uint8_t bit = 0; bit < 40; bit++) {
+        uint16_t high = (uint16_t)(e[first + 2 * bit + 1] - e[first + 2 * bit]);
+        if (high > DHT_IC_PULSE_MAX) {
+            return HAL_ERROR; // Front manqué ou parasite
+        }
+        bytes[bit >> 3] = (uint8_t)(bytes[bit >> 3] << 1) | (high > DHT_IC_BIT_THRESHOLD);
+    }
+
+    h->sensor->hum1 = bytes[0];
+    h->sensor->hum2 = bytes[1];
+    h->sensor->temp1 = bytes[2];
+    h->sensor->temp2 = bytes[3];
+    h->sensor->SUM = bytes[4];
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef DHT_IC_Init(DHT_IC_Handle* h, DHT_Sensor* sensor, uint32_t channel, uint32_t alternate,
+                              DHT_IC_Callback callback, void* ctx) {
+    if (!h || !sensor || !sensor->htim || !callback) {
+        return HAL_ERROR;
+    }
+    h->sensor = sensor;
+    h->channel = channel;
+    h->alternate = alternate;
+    h->callback = callback;
+    h->ctx = ctx;
+    h->state = DHT_IC_IDLE;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef DHT_IC_Start(DHT_IC_Handle* h) {
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+    if (!h || !h->sensor) {
+        return HAL_ERROR;
+    }
+    if (h->state != DHT_IC_IDLE) {
+        return HAL_BUSY;
+    }
+
+    // Impulsion de démarrage : la broche est reprise en sortie, sa durée est mesurée par DHT_IC_Process
+    GPIO_InitStruct.Pin = h->sensor->DHT_PIN;
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    HAL_GPIO_Init(h->sensor->DHT_PORT, &GPIO_InitStruct);
+    HAL_GPIO_WritePin(h->sensor->DHT_PORT, h->sensor->DHT_PIN, GPIO_PIN_RESET);
+
+    h->startTick = HAL_GetTick();
+    h->state = DHT_IC_START_LOW;
+    return HAL_OK;
+}
+
+void DHT_IC_Process(DHT_IC_Handle* h) {
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+    const float none[2] = {0.0f, 0.0f}; // Pas de mesure en cas d'erreur
+    uint32_t lowTime;
+
+    if (!h) {
+        return;
+    }
+
+    if (h->state == DHT_IC_START_LOW) {
+        lowTime = (h->sensor->sensorType == DHT11) ? DHT_IC_START_LOW_MS_DHT11 : DHT_IC_START_LOW_MS_DHT22;
+        if ((uint32_t)(HAL_GetTick() - h->startTick) < lowTime) {
+            return;
+        }
+        // Relâche la ligne en la passant directement sur le canal de capture (tirage haut)
+        GPIO_InitStruct.Pin = h->sensor->DHT_PIN;
+        GPIO_InitStruct.Mode = GPIO_MODE_AF_OD;
+        GPIO_InitStruct.Pull = GPIO_PULLUP;
+        GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+        GPIO_InitStruct.Alternate = h->alternate;
+        h->state = DHT_IC_CAPTURE; // Avant le démarrage : la fin de DMA peut survenir très tôt
+        h->startTick = HAL_GetTick();
+        // Le tampon est en demi-mots : la largeur réelle des transferts est celle du canal DMA (Half Word)
+        if (HAL_TIM_IC_Start_DMA(h->sensor->htim, h->channel, (uint32_t*)h->edges, DHT_IC_EDGES) != HAL_OK) {
+            // Relâche quand même la ligne (entrée, tirage haut) : sinon le capteur reste bloqué
+            // dans la condition de démarrage
+            GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
+            GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+            GPIO_InitStruct.Alternate = 0;
+            HAL_GPIO_Init(h->sensor->DHT_PORT, &GPIO_InitStruct);
+            h->state = DHT_IC_IDLE;
+            h->callback(h->sensor, HAL_ERROR, none, h->ctx);
+            return;
+        }
+        HAL_GPIO_Init(h->sensor->DHT_PORT, &GPIO_InitStruct);
+    } else if (h->state == DHT_IC_CAPTURE) {
+        if ((uint32_t)(HAL_GetTick() - h->startTick) <= DHT_IC_TIMEOUT_MS) {
+            return;
+        }
+        // Capteur absent ou trame incomplète
+        HAL_TIM_IC_Stop_DMA(h->sensor->htim, h->channel);
+        h->state = DHT_IC_IDLE;
+        h->callback(h->sensor, HAL_TIMEOUT, none, h->ctx);
+    }
+}
+
+void DHT_IC_CaptureCallback(DHT_IC_Handle* h, TIM_HandleTypeDef* htim) {
+    HAL_StatusTypeDef status;
+    float data[2] = {0};
+
+    if (!h || h->state != DHT_IC_CAPTURE || htim != h->sensor->htim ||
+        htim->Channel != DHT_IC_ActiveChannel(h->channel)) {
+        return; // Capture d'un autre canal ou d'un autre capteur
+    }
+
+    HAL_TIM_IC_Stop_DMA(htim, h->channel);
+    h->state = DHT_IC_IDLE;
+    status = DHT_IC_Decode(h);
+    if (status == HAL_OK) {
+        status = DHT_Convert(h->sensor, data);
+    }
+    h->callback(h->sensor, status, data, h->ctx);
+}
+
+// --- Ordonnanceur multi-capteurs ---
+
+HAL_StatusTypeDef DHT_Sched_Init(DHT_Scheduler* sched, DHT_Sensor* const sensors[], uint8_t count, uint32_t period_ms) {
+    uint32_t now = HAL_GetTick();
+    uint32_t stagger;
+
+    if (!sched || !sensors || count == 0 || count > DHT_SCHED_MAX_SENSORS) {
+        return HAL_ERROR;
+    }
+
+    // Période effective : au moins l'intervalle minimal du capteur le plus lent
+    for (uint8_t i = 0; i < count; i++) {
+        if (!sensors[i]) {
+            return HAL_ERROR;
+        }
+        if (sensors[i]->sensorType != DHT11 && period_ms < DHT22_MIN_INTERVAL_MS) {
+            period_ms = DHT22_MIN_INTERVAL_MS;
+        } else if (period_ms < DHT11_MIN_INTERVAL_MS) {
+            period_ms = DHT11_MIN_INTERVAL_MS;
+        }
+    }
+
+    // Les capteurs partagent le timer et la boucle : on étale leurs lectures sur la période
+    stagger = period_ms / count;
+    for (uint8_t i = 0; i < count; i++) {
+        DHT_SchedEntry* e = &sched->entries[i];
+        uint32_t minInterval = (sensors[i]->sensorType == DHT11) ? DHT11_MIN_INTERVAL_MS : DHT22_MIN_INTERVAL_MS;
+
+        e->sensor = sensors[i];
+        e->period = period_ms;
+        // Première lecture décalée : le capteur doit aussi être alimenté depuis plus d'un intervalle
+        e->nextTick = now + minInterval + i * stagger;
+        e->valid = 0;
+        e->errors = 0;
+        e->data[0] = 0.0f;
+        e->data[1] = 0.0f;
+    }
+    sched->count = count;
+    sched->next = 0;
+    return HAL_OK;
+}
+
+int8_t DHT_Sched_Process(DHT_Scheduler* sched) {
+    uint32_t now;
+    float data[2];
+
+    if (!sched) {
+        return -1;
+    }
+
+    now = HAL_GetTick();
+    for (uint8_t n = 0; n < sched->count; n++) {
+        uint8_t i = (uint8_t)((sched->next + n) % sched->count);
+        DHT_SchedEntry* e = &sched->entries[i];
+
+        if ((int32_t)(now - e->nextTick) < 0) {
+            continue; // Pas encore à échéance
+        }
+
+        // Un échec compte aussi comme une lecture : l'intervalle minimal s'applique dans tous les cas
+        if (DHT_GetData(e->sensor, data) == HAL_OK) {
+            e->data[0] = data[0];
+            e->data[1] = data[1];
+            e->lastGoodTick = now;
+            e->valid = 1;
+            e->errors = 0;
+        } else if (e->errors < 255) {
+            e->errors++;
+        }
+
+        // Garde le décalage entre capteurs ; en cas de retard, repart de maintenant
+        e->nextTick += e->period;
+        if ((int32_t)(now - e->nextTick) >= 0) {
+            e->nextTick = now + e->period;
+        }
+        sched->next = (uint8_t)((i + 1) % sched->count);
+        return (int8_t)i;
+    }
+    return -1;
+}
+
+HAL_StatusTypeDef DHT_Sched_Get(const DHT_Scheduler* sched, uint8_t index, float data[2], uint32_t* age_ms) {
+    const DHT_SchedEntry* e;
+
+    if (!sched || !data || index >= sched->count) {
+        return HAL_ERROR;
+    }
+    e = &sched->entries[index];
+    if (!e->valid) {
+        return HAL_ERROR;
+    }
+    data[0] = e->data[0];
+    data[1] = e->data[1];
+    if (age_ms) {
+        *age_ms = HAL_GetTick() - e->lastGoodTick;
+    }
+    return HAL_OK;
+}
@@ -82,4 +82,162 @@ HAL_StatusTypeDef DHT_Init(DHT_Sensor *sensor, TIM_HandleTypeDef *htim, GPIO_Typ
  */
 HAL_StatusTypeDef DHT_GetData(DHT_Sensor *sensor, float data[2]);
 
+/**
+ * @defgroup DHT_IC Lecture non bloquante par capture d'entrée
+ * @brief Moteur alternatif à DHT_GetData : les fronts de la trame sont horodatés par un canal
+ *        de capture d'entrée du timer (fronts montants et descendants) et transférés par DMA,
+ *        puis la trame est décodée à partir des largeurs d'impulsions.
+ *
+ * Configuration requise (CubeMX) : la broche du capteur est reliée à un canal du timer de DHT_Init
+ * (1 tick = 1 µs, ARR = 0xFFFF), canal en Input Capture sur les deux fronts, DMA associé au canal
+ * (Peripheral To Memory, Normal, largeur Half Word / Half Word : valeur par défaut de CubeMX).
+ * Le CPU n'est occupé que pendant l'impulsion de démarrage (pilotée par HAL_GetTick) et le décodage ;
+ * la latence des interruptions n'influence pas la mesure.
+ * @{
+ */
+#define DHT_IC_EDGES 84 ///< Fronts capturés : réponse (3 ou 4 selon le relâchement de la ligne) + 40 bits x 2
+
+/**
+ * @brief Callback de fin de lecture, appelé depuis le callback de capture HAL (contexte interruption)
+ *        ou depuis DHT_IC_Process en cas de timeout.
+ * @param sensor Capteur concerné (octets bruts mis à jour si status == HAL_OK).
+ * @param status HAL_OK, HAL_ERROR (somme de contrôle ou trame invalide) ou HAL_TIMEOUT.
+ * @param data data[0] = température en °C, data[1] = humidité en % (valides si status == HAL_OK, 0 sinon).
+ * @param ctx Pointeur utilisateur fourni à DHT_IC_Init.
+ */
+typedef void (*DHT_IC_Callback)(DHT_Sensor *sensor, HAL_StatusTypeDef status, const float data[2], void *ctx);
+
+/**
+ * @brief États du moteur de capture.
+ */
+typedef enum
+{
+    DHT_IC_IDLE = 0,  ///< Aucune lecture en cours
+    DHT_IC_START_LOW, ///< Impulsion de démarrage en cours (ligne maintenue basse)
+    DHT_IC_CAPTURE    ///< Capture DMA des fronts en cours
+} DHT_IC_State;
+
+/**
+ * @struct DHT_IC_Handle
+ * @brief Contexte d'une lecture par capture d'entrée (un par capteur).
+ */
+typedef struct
+{
+    DHT_Sensor *sensor;               ///< Capteur initialisé par DHT_Init (port, broche, type, timer).
+    uint32_t channel;                 ///< Canal de capture (TIM_CHANNEL_1 à TIM_CHANNEL_4).
+    uint32_t alternate;               ///< Fonction alternative de la broche vers le timer (ex: GPIO_AF2_TIM2).
+    uint16_t edges[DHT_IC_EDGES];     ///< Horodatages des fronts (remplis par DMA en Half Word).
+    volatile DHT_IC_State state;      ///< État courant.
+    uint32_t startTick;               ///< HAL_GetTick() au début de l'étape courante.
+    DHT_IC_Callback callback;         ///< Callback de fin de lecture.
+    void *ctx;                        ///< Pointeur utilisateur transmis au callback.
+} DHT_IC_Handle;
+
+/**
+ * @brief Associe un capteur à un canal de capture d'entrée.
+ * @param h Contexte à initialiser.
+ * @param sensor Capteur déjà initialisé par DHT_Init (timer démarré).
+ * @param channel Canal de capture (TIM_CHANNEL_x) relié à la broche du capteur.
+ * @param alternate Fonction alternative de la broche (GPIO_AFx_TIMy).
+ * @param callback Callback de fin de lecture (ne doit pas être NULL).
+ * @param ctx Pointeur utilisateur transmis au callback.
+ * @return HAL_OK, ou HAL_ERROR si un pointeur est NULL.
+ */
+HAL_StatusTypeDef DHT_IC_Init(DHT_IC_Handle *h, DHT_Sensor *sensor, uint32_t channel, uint32_t alternate,
+                              DHT_IC_Callback callback, void *ctx);
+
+/**
+ * @brief Démarre une lecture : met la ligne à l'état bas et rend la main immédiatement.
+ * @param h Contexte de capture.
+ * @return HAL_OK, HAL_BUSY si une lecture est déjà en cours, HAL_ERROR si h est invalide.
+ */
+HAL_StatusTypeDef DHT_IC_Start(DHT_IC_Handle *h);
+
+/**
+ * @brief A appeler régulièrement (boucle principale ou tick 1 ms) : termine l'impulsion de démarrage,
+ *        lance la capture DMA et signale un timeout si la trame n'arrive pas.
+ * @param h Contexte de capture.
+ */
+void DHT_IC_Process(DHT_IC_Handle *h);
+
+/**
+ * @brief A appeler depuis HAL_TIM_IC_CaptureCallback : décode la trame si la capture concerne
+ *        ce capteur (timer et canal) et appelle le callback utilisateur.
+ * @param h Contexte de capture.
+ * @param htim Timer passé à HAL_TIM_IC_CaptureCallback.
+ */
+void DHT_IC_CaptureCallback(DHT_IC_Handle *h, TIM_HandleTypeDef *htim);
+/** @} */
+
+/**
+ * @defgroup DHT_Sched Ordonnanceur multi-capteurs
+ * @brief Lit un ensemble de capteurs DHT à tour de rôle en décalant les impulsions de démarrage,
+ *        en respectant l'intervalle minimal de chaque capteur (1 s pour le DHT11, 2 s pour le DHT22/21)
+ *        et en conservant la dernière mesure valide. Les consommateurs lisent le cache
+ *        (DHT_Sched_Get) et ne dépendent jamais du protocole filaire.
+ * @{
+ */
+#ifndef DHT_SCHED_MAX_SENSORS
+#define DHT_SCHED_MAX_SENSORS 8 ///< Nombre maximal de capteurs gérés par un ordonnanceur
+#endif
+
+#define DHT11_MIN_INTERVAL_MS 1000 ///< Intervalle minimal entre deux lectures d'un DHT11
+#define DHT22_MIN_INTERVAL_MS 2000 ///< Intervalle minimal entre deux lectures d'un DHT22/21
+
+/**
+ * @struct DHT_SchedEntry
+ * @brief État d'un capteur dans l'ordonnanceur.
+ */
+typedef struct
+{
+    DHT_Sensor *sensor;    ///< Capteur initialisé par DHT_Init.
+    float data[2];         ///< Dernière mesure valide : data[0] = °C, data[1] = %.
+    uint32_t period;       ///< Période de lecture effective en ms (>= intervalle minimal).
+    uint32_t nextTick;     ///< HAL_GetTick() de la prochaine lecture.
+    uint32_t lastGoodTick; ///< HAL_GetTick() de la dernière mesure valide.
+    uint8_t valid;         ///< 1 dès qu'une mesure valide est en cache.
+    uint8_t errors;        ///< Échecs consécutifs depuis la dernière mesure valide (saturé à 255).
+} DHT_SchedEntry;
+
+/**
+ * @struct DHT_Scheduler
+ * @brief Ordonnanceur de lecture d'un ensemble de capteurs DHT.
+ */
+typedef struct
+{
+    DHT_SchedEntry entries[DHT_SCHED_MAX_SENSORS]; ///< Un élément par capteur.
+    uint8_t count;                                 ///< Nombre de capteurs gérés.
+    uint8_t next;                                  ///< Prochain capteur examiné (tourniquet).
+} DHT_Scheduler;
+
+/**
+ * @brief Initialise l'ordonnanceur et répartit les premières lectures sur une période.
+ * @param sched Ordonnanceur à initialiser.
+ * @param sensors Tableau de pointeurs vers des capteurs déjà initialisés par DHT_Init.
+ * @param count Nombre de capteurs (1 à DHT_SCHED_MAX_SENSORS).
+ * @param period_ms Période de lecture souhaitée, commune à tous les capteurs ; relevée si nécessaire
+ *                  à l'intervalle minimal du type le plus lent.
+ * @return HAL_OK, ou HAL_ERROR si un paramètre est invalide.
+ */
+HAL_StatusTypeDef DHT_Sched_Init(DHT_Scheduler *sched, DHT_Sensor *const sensors[], uint8_t count, uint32_t period_ms);
+
+/**
+ * @brief A appeler depuis la boucle principale : lit au plus un capteur arrivé à échéance
+ *        (une trame DHT_GetData, ~5 ms) et met son cache à jour.
+ * @param sched Ordonnanceur.
+ * @return Index du capteur lu, ou -1 si aucun n'était à échéance.
+ */
+int8_t DHT_Sched_Process(DHT_Scheduler *sched);
+
+/**
+ * @brief Retourne la dernière mesure valide d'un capteur, sans accès au capteur.
+ * @param sched Ordonnanceur.
+ * @param index Index du capteur (ordre du tableau passé à DHT_Sched_Init).
+ * @param data Tableau recevant data[0] = °C et data[1] = %.
+ * @param age_ms Âge de la mesure en ms (peut être NULL).
+ * @return HAL_OK, ou HAL_ERROR si l'index est invalide ou si aucune mesure valide n'existe encore.
+ */
+HAL_StatusTypeDef DHT_Sched_Get(const DHT_Scheduler *sched, uint8_t index, float data[2], uint32_t *age_ms);
+/** @} */
+
 #endif /* INC_STM32_DHT_H_ */
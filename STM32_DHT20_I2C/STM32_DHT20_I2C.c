@@ -6,6 +6,7 @@
  */
 
 #include "STM32_DHT20_I2C.h"
+#include "STM32_CRC8.h" // Shared CRC8 (STM32_CRC8 folder)
 
 // --- Debug Configuration ---
 // Décommentez la ligne suivante pour activer les messages de débogage via printf
@@ -23,9 +24,6 @@
 #define DHT20_STATUS_BUSY_MASK 0x80         // Mask to check if the sensor is busy
 #define DHT20_STATUS_CALIBRATED_MASK 0x08   // Mask to check if the sensor is calibrated
 
-// --- Private Function Prototypes ---
-static uint8_t DHT20_CalculateCRC8(uint8_t *data, uint8_t len);
-
 // --- Function Implementations ---
 
 /**
@@ -34,24 +32,7 @@ static uint8_t DHT20_CalculateCRC8(uint8_t *data, uint8_t len);
 void DHT20_Init(DHT20_Handle *dht, I2C_HandleTypeDef *hi2c, uint32_t timeout) {
     dht->hi2c = hi2c;
     dht->i2c_timeout = timeout;
-}
-
-/**
- * @brief Calculates the CRC8 for DHT20 data. (Internal function)
- */
-static uint8_t DHT20_CalculateCRC8(uint8_t *data, uint8_t len) {
-    uint8_t crc = 0xFF; // Initialize with 0xFF
-    for (uint8_t i = 0; i < len; i++) {
-        crc ^= data[i];
-        for (uint8_t j = 0; j < 8; j++) {
-            if (crc & 0x80) {
-                crc = (crc << 1) ^ 0x31; // Polynomial 0x31 (x^8 + x^5 + x^4 + 1)
-            } else {
-                crc <<= 1;
-            }
-        }
-    }
-    return crc;
+    dht->ready_tick = 0;
 }
 
 /**
@@ -82,31 +63,43 @@ HAL_StatusTypeDef DHT20_Check_Status(DHT20_Handle *dht) {
 }
 
 /**
- * @brief Reads temperature and humidity data from the DHT20 sensor.
+ * @brief Starts a measurement without waiting for it.
  */
-HAL_StatusTypeDef DHT20_ReadData(DHT20_Handle *dht, float *temperature, float *humidity) {
+HAL_StatusTypeDef DHT20_Trigger(DHT20_Handle *dht) {
     uint8_t cmd_trigger[] = DHT20_CMD_TRIGGER;
-    uint8_t data[7]; // 1 status + 6 data + 1 CRC
     HAL_StatusTypeDef status;
 
-    // 1. Send trigger measurement command
     status = HAL_I2C_Master_Transmit(dht->hi2c, DHT20_SENSOR_ADDR, cmd_trigger, sizeof(cmd_trigger), dht->i2c_timeout);
     if (status != HAL_OK) {
         DHT20_PRINTF("Erreur: Échec de l'envoi de la commande de mesure DHT20\r\n");
         return status;
     }
+    dht->ready_tick = HAL_GetTick() + DHT20_MEASUREMENT_TIME_MS;
+    return HAL_OK;
+}
 
-    // 2. Wait for measurement completion (min 80ms)
-    HAL_Delay(100); // Wait 100ms to be safe
+/**
+ * @brief Tells whether the triggered measurement has reached its ready time.
+ */
+uint8_t DHT20_IsReady(const DHT20_Handle *dht) {
+    return (int32_t)(HAL_GetTick() - dht->ready_tick) >= 0;
+}
+
+/**
+ * @brief Reads the result of a triggered measurement.
+ */
+HAL_StatusTypeDef DHT20_Collect(DHT20_Handle *dht, float *temperature, float *humidity) {
+    uint8_t data[7]; // 1 status + 5 data + 1 CRC
+    HAL_StatusTypeDef status;
 
-    // 3. Read 7 bytes (Status, RH, Temp, CRC)
+    // 1. Read 7 bytes (Status, RH, Temp, CRC)
     status = HAL_I2C_Master_Receive(dht->hi2c, DHT20_SENSOR_ADDR, data, sizeof(data), dht->i2c_timeout);
     if (status != HAL_OK) {
         DHT20_PRINTF("Erreur: Échec de la lecture des données DHT20\r\n");
         return status;
     }
 
-    // 4. Check status byte
+    // 2. Check status byte
     if (data[0] & DHT20_STATUS_BUSY_MASK) {
         DHT20_PRINTF("Erreur: Capteur DHT20 occupé\r\n");
         return HAL_BUSY;
@@ -116,14 +109,14 @@ HAL_StatusTypeDef DHT20_ReadData(DHT20_Handle *dht, float *temperature, float *h
         // Decide if this is an error for your application: return HAL_ERROR;
     }
 
-    // 5. Verify CRC
-    uint8_t calculated_crc = DHT20_CalculateCRC8(data, 6); // CRC is calculated over the first 6 bytes
+    // 3. Verify CRC
+    uint8_t calculated_crc = CRC8_Poly31(data, 6, 0xFF); // CRC is calculated over the first 6 bytes (polynomial 0x31, init 0xFF)
     if (calculated_crc != data[6]) {
         DHT20_PRINTF("Erreur: CRC invalide! Calculé: 0x%02X, Reçu: 0x%02X\r\n", calculated_crc, data[6]);
         return HAL_ERROR; // Data integrity error
     }
 
-    // 6. Calculate raw values and convert to Temperature/Humidity
+    // 4. Calculate raw values and convert to Temperature/Humidity
     uint32_t humidity_raw = ((uint32_t)data[1] << 12) | ((uint32_t)data[2] << 4) | (((uint32_t)data[3] & 0xF0) >> 4);
     uint32_t temperature_raw = (((uint32_t)data[3] & 0x0F) << 16) | ((uint32_t)data[4] << 8) | (uint32_t)data[5];
 
@@ -132,3 +125,40 @@ HAL_StatusTypeDef DHT20_ReadData(DHT20_Handle *dht, float *temperature, float *h
 
     return HAL_OK;
 }
+
+/**
+ * @brief Collects as soon as the busy bit has cleared.
+ */
+HAL_StatusTypeDef DHT20_Poll(DHT20_Handle *dht, float *temperature, float *humidity) {
+    uint8_t status_byte;
+    HAL_StatusTypeDef status;
+
+    // A single status byte is cheaper than the full frame while the sensor is still busy
+    status = HAL_I2C_Master_Receive(dht->hi2c, DHT20_SENSOR_ADDR, &status_byte, 1, dht->i2c_timeout);
+    if (status != HAL_OK) {
+        return status;
+    }
+    if (status_byte & DHT20_STATUS_BUSY_MASK) {
+        return HAL_BUSY;
+    }
+    return DHT20_Collect(dht, temperature, humidity);
+}
+
+/**
+ * @brief Reads temperature and humidity data from the DHT20 sensor.
+ */
+HAL_StatusTypeDef DHT20_ReadData(DHT20_Handle *dht, float *temperature, float *humidity) {
+    HAL_StatusTypeDef status;
+
+    // 1. Send trigger measurement command
+    status = DHT20_Trigger(dht);
+    if (status != HAL_OK) {
+        return status;
+    }
+
+    // 2. Wait for measurement completion (min 80ms)
+    HAL_Delay(100); // Wait 100ms to be safe
+
+    // 3. Read and check the result
+    return DHT20_Collect(dht, temperature, humidity);
+}
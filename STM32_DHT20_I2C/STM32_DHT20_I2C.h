@@ -13,6 +13,7 @@
 
 // Define the default I2C address for the DHT20 sensor
 #define DHT20_SENSOR_ADDR (0x38 << 1) // Shifted left to match STM32 HAL requirements
+#define DHT20_MEASUREMENT_TIME_MS 80 // Measurement duration after a trigger (datasheet: 80 ms)
 
 /**
  * @brief DHT20 Sensor Handle Structure.
@@ -22,6 +23,7 @@ typedef struct
 {
     I2C_HandleTypeDef *hi2c; // Pointer to the I2C handle initialized in main.c
     uint32_t i2c_timeout;    // Timeout for I2C operations in ms
+    uint32_t ready_tick;     // HAL_GetTick() value at which the triggered measurement is ready
 } DHT20_Handle;
 
 /**
@@ -48,4 +50,38 @@ HAL_StatusTypeDef DHT20_Check_Status(DHT20_Handle *dht);
  */
 HAL_StatusTypeDef DHT20_ReadData(DHT20_Handle *dht, float *temperature, float *humidity);
 
+/**
+ * @brief Starts a measurement and returns immediately (split-phase API).
+ *        Several sensors can be triggered, then collected in a single pass.
+ * @param dht Pointer to the initialized DHT20_Handle structure.
+ * @retval HAL_StatusTypeDef HAL status of the I2C transmission.
+ */
+HAL_StatusTypeDef DHT20_Trigger(DHT20_Handle *dht);
+
+/**
+ * @brief Tells whether the measurement started by DHT20_Trigger has reached its ready time.
+ * @param dht Pointer to the initialized DHT20_Handle structure.
+ * @retval 1 if the data can be collected, 0 otherwise.
+ */
+uint8_t DHT20_IsReady(const DHT20_Handle *dht);
+
+/**
+ * @brief Reads the result of a triggered measurement.
+ * @param dht Pointer to the initialized DHT20_Handle structure.
+ * @param temperature Pointer to a float variable to store the temperature in Celsius.
+ * @param humidity Pointer to a float variable to store the relative humidity in %.
+ * @retval HAL_StatusTypeDef HAL_OK, HAL_BUSY if the conversion is still running, HAL_ERROR on CRC error.
+ */
+HAL_StatusTypeDef DHT20_Collect(DHT20_Handle *dht, float *temperature, float *humidity);
+
+/**
+ * @brief Reads the status byte only and collects as soon as the busy bit has cleared,
+ *        possibly before the ready time.
+ * @param dht Pointer to the initialized DHT20_Handle structure.
+ * @param temperature Pointer to a float variable to store the temperature in Celsius.
+ * @param humidity Pointer to a float variable to store the relative humidity in %.
+ * @retval HAL_StatusTypeDef Same as DHT20_Collect (HAL_BUSY while the sensor is measuring).
+ */
+HAL_StatusTypeDef DHT20_Poll(DHT20_Handle *dht, float *temperature, float *humidity);
+
 #endif /* INC_STM32_DHT20_I2C_H_ */
@@ -1,5 +1,6 @@
 #include "config.h"
 #include "onewire.h"
+#include "STM32_CRC8.h" // CRC8 partagé (dossier STM32_CRC8)
 
 //
 // Fonction de délai pour les timings constants du bus 1-Wire
@@ -311,21 +312,7 @@ void OneWire_GetFullROM(OneWire_t* onewire, uint8_t *firstIndex)
 // Calcul du CRC
 //
 uint8_t OneWire_CRC8(uint8_t *addr, uint8_t len) {
-    uint8_t crc = 0, inbyte, i, mix;
-
-    while (len--) {
-        inbyte = *addr++; // Récupère l'octet suivant
-        for (i = 8; i; i--) { // Parcourt les 8 bits de l'octet
-            mix = (crc ^ inbyte) & 0x01; // Calcule le bit de parité
-            crc >>= 1; // Décale le CRC vers la droite
-            if (mix) {
-                crc ^= 0x8C; // Applique le polynôme si nécessaire
-            }
-            inbyte >>= 1; // Décale l'octet vers la droite
-        }
-    }
-
-    return crc; // Retourne le CRC calculé
+    return CRC8_Maxim(addr, len); // CRC Dallas/Maxim partagé (dossier STM32_CRC8)
 }
 
 //
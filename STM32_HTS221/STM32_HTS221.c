@@ -5,7 +5,10 @@
 #define HTS221_I2C_ADDRESS    (0x5F << 1)  // Adresse I2C pour le HTS221 (format 8 bits)
 
 #define HTS221_WHO_AM_I_REG       0x0F     // Registre d'identification du capteur
+#define HTS221_AV_CONF_REG        0x10     // Registre de configuration du moyennage
 #define HTS221_CTRL_REG1          0x20     // Registre de contrôle principal
+#define HTS221_CTRL_REG3          0x22     // Registre de contrôle de la broche DRDY
+#define HTS221_STATUS_REG         0x27     // Registre d'état (bits T_DA / H_DA)
 #define HTS221_HUMIDITY_OUT_L_REG 0x28     // Registre de sortie de l'humidité (LSB)
 #define HTS221_HUMIDITY_OUT_H_REG 0x29     // Registre de sortie de l'humidité (MSB)
 #define HTS221_TEMP_OUT_L_REG     0x2A     // Registre de sortie de la température (LSB)
@@ -27,6 +30,20 @@
 #define HTS221_H1_T0_OUT_L_REG      0x3A   // Sortie brute H1 (LSB)
 #define HTS221_H1_T0_OUT_H_REG      0x3B   // Sortie brute H1 (MSB)
 
+#define HTS221_AUTO_INCREMENT       0x80   // Bit 7 de l'adresse : auto-incrément en lecture multi-octets
+#define HTS221_CALIB_FIRST_REG      HTS221_H0_RH_X2_REG // Début du bloc de calibration (0x30..0x3F)
+#define HTS221_CALIB_LEN            16     // Taille du bloc de calibration
+
+#define HTS221_STATUS_T_DA          0x01   // Nouvelle température disponible
+#define HTS221_STATUS_H_DA          0x02   // Nouvelle humidité disponible
+
+#define HTS221_CTRL1_PD             0x80   // Capteur actif
+#define HTS221_CTRL1_BDU            0x04   // Mise à jour par bloc : L et H appartiennent au même échantillon
+#define HTS221_CTRL1_ODR_MASK       0x03   // Bits de fréquence d'échantillonnage
+#define HTS221_CTRL3_DRDY_EN        0x04   // Signal "données prêtes" sur la broche DRDY (push-pull, actif haut)
+
+#define HTS221_STREAM_DRAIN_MAX     4      // Tentatives maximales pour faire retomber DRDY au démarrage du streaming
+
 /* Structure pour les données de calibration */
 typedef struct {
     float T0_degC;       // Température T0 en °C
@@ -37,13 +54,20 @@ typedef struct {
     float H1_rh;         // Humidité H1 en %
     int16_t H0_T0_OUT;   // Sortie brute pour H0
     int16_t H1_T0_OUT;   // Sortie brute pour H1
+    float T_slope;       // Pente précalculée : T = T_slope * brut + T_offset
+    float T_offset;      // Ordonnée à l'origine précalculée pour la température
+    float H_slope;       // Pente précalculée : H = H_slope * brut + H_offset
+    float H_offset;      // Ordonnée à l'origine précalculée pour l'humidité
+    uint8_t T_valid;     // 1 si la calibration température est exploitable
+    uint8_t H_valid;     // 1 si la calibration humidité est exploitable
 } HTS221_CalibrationData;
 
 static HTS221_CalibrationData calib_data; // Instance globale pour stocker les données de calibration
 
 /* Prototypes de fonctions privées */
 static uint8_t HTS221_ReadReg(I2C_HandleTypeDef *hi2c, uint8_t reg); // Lecture d'un registre
-static void HTS221_WriteReg(I2C_HandleTypeDef *hi2c, uint8_t reg, uint8_t value); // Écriture dans un registre
+static HAL_StatusTypeDef HTS221_ReadRegs(I2C_HandleTypeDef *hi2c, uint8_t reg, uint8_t *buf, uint16_t len); // Lecture multi-octets
+static HAL_StatusTypeDef HTS221_WriteReg(I2C_HandleTypeDef *hi2c, uint8_t reg, uint8_t value); // Écriture dans un registre
 static HTS221_Status HTS221_ReadCalibrationData(I2C_HandleTypeDef *hi2c); // Lecture des données de calibration
 
 /**
@@ -51,12 +75,15 @@ static HTS221_Status HTS221_ReadCalibrationData(I2C_HandleTypeDef *hi2c); // Lec
  * @param hi2c: Pointeur vers la structure I2C.
  * @param reg: Adresse du registre.
  * @param value: Valeur à écrire.
+ * @retval Statut HAL de la transaction.
  */
-static void HTS221_WriteReg(I2C_HandleTypeDef *hi2c, uint8_t reg, uint8_t value) {
+static HAL_StatusTypeDef HTS221_WriteReg(I2C_HandleTypeDef *hi2c, uint8_t reg, uint8_t value) {
     uint8_t data[2] = {reg, value};
-    if (HAL_I2C_Master_Transmit(hi2c, HTS221_I2C_ADDRESS, data, 2, HAL_MAX_DELAY) != HAL_OK) {
+    HAL_StatusTypeDef status = HAL_I2C_Master_Transmit(hi2c, HTS221_I2C_ADDRESS, data, 2, HAL_MAX_DELAY);
+    if (status != HAL_OK) {
         printf("Erreur HTS221: Ecriture registre 0x%02X\r\n", reg);
     }
+    return status;
 }
 
 /**
@@ -78,40 +105,99 @@ static uint8_t HTS221_ReadReg(I2C_HandleTypeDef *hi2c, uint8_t reg) {
     return value;
 }
 
+/**
+ * @brief Lit plusieurs registres consécutifs en une seule transaction I2C.
+ * @param hi2c: Pointeur vers la structure I2C.
+ * @param reg: Adresse du premier registre.
+ * @param buf: Tampon de réception.
+ * @param len: Nombre d'octets à lire.
+ * @retval Statut HAL de la transaction.
+ * @note  Le bit 7 de l'adresse active l'auto-incrément du HTS221 ; sans lui,
+ *        le capteur renverrait len fois le même registre.
+ */
+static HAL_StatusTypeDef HTS221_ReadRegs(I2C_HandleTypeDef *hi2c, uint8_t reg, uint8_t *buf, uint16_t len) {
+    HAL_StatusTypeDef status = HAL_I2C_Mem_Read(hi2c, HTS221_I2C_ADDRESS, (uint16_t)(reg | HTS221_AUTO_INCREMENT),
+                                                I2C_MEMADD_SIZE_8BIT, buf, len, HAL_MAX_DELAY);
+    if (status != HAL_OK) {
+        printf("Erreur HTS221: Lecture bloc 0x%02X (%u octets)\r\n", reg, len);
+    }
+    return status;
+}
+
 /**
  * @brief Lit les données de calibration du HTS221.
  * @param hi2c: Pointeur vers la structure I2C.
  * @retval Statut de l'opération.
  */
 static HTS221_Status HTS221_ReadCalibrationData(I2C_HandleTypeDef *hi2c) {
-    // Lecture des températures T0 et T1
-    uint8_t t0_degc_x8_val = HTS221_ReadReg(hi2c, HTS221_T0_DEGC_X8_REG);
-    uint8_t t1_degc_x8_val = HTS221_ReadReg(hi2c, HTS221_T1_DEGC_X8_REG);
-    uint8_t t0_t1_msb_val = HTS221_ReadReg(hi2c, HTS221_T0_T1_DEGC_MSB_REG);
+    uint8_t c[HTS221_CALIB_LEN];
 
-    // Conversion des valeurs brutes en °C
-    calib_data.T0_degC = (float)((((uint16_t)(t0_t1_msb_val & 0x03)) << 8) | (uint16_t)t0_degc_x8_val) / 8.0f;
-    calib_data.T1_degC = (float)((((uint16_t)(t0_t1_msb_val & 0x0C)) << 6) | (uint16_t)t1_degc_x8_val) / 8.0f;
+    // Lecture du bloc 0x30..0x3F en une seule transaction
+    if (HTS221_ReadRegs(hi2c, HTS221_CALIB_FIRST_REG, c, HTS221_CALIB_LEN) != HAL_OK) {
+        return HTS221_ERROR;
+    }
+#define CAL(reg) c[(reg) - HTS221_CALIB_FIRST_REG]
+#define CAL16(reg_l) (int16_t)(((uint16_t)CAL((reg_l) + 1) << 8) | (uint16_t)CAL(reg_l))
 
-    // Lecture des sorties brutes pour T0 et T1
-    calib_data.T0_OUT = (int16_t)(((uint16_t)HTS221_ReadReg(hi2c, HTS221_T0_OUT_H_REG) << 8) | (uint16_t)HTS221_ReadReg(hi2c, HTS221_T0_OUT_L_REG));
-    calib_data.T1_OUT = (int16_t)(((uint16_t)HTS221_ReadReg(hi2c, HTS221_T1_OUT_H_REG) << 8) | (uint16_t)HTS221_ReadReg(hi2c, HTS221_T1_OUT_L_REG));
+    // Conversion des valeurs brutes en °C
+    uint8_t t0_t1_msb_val = CAL(HTS221_T0_T1_DEGC_MSB_REG);
+    calib_data.T0_degC = (float)((((uint16_t)(t0_t1_msb_val & 0x03)) << 8) | (uint16_t)CAL(HTS221_T0_DEGC_X8_REG)) / 8.0f;
+    calib_data.T1_degC = (float)((((uint16_t)(t0_t1_msb_val & 0x0C)) << 6) | (uint16_t)CAL(HTS221_T1_DEGC_X8_REG)) / 8.0f;
 
-    // Lecture des humidités H0 et H1
-    uint8_t h0_rh_x2_val = HTS221_ReadReg(hi2c, HTS221_H0_RH_X2_REG);
-    uint8_t h1_rh_x2_val = HTS221_ReadReg(hi2c, HTS221_H1_RH_X2_REG);
+    // Sorties brutes pour T0 et T1
+    calib_data.T0_OUT = CAL16(HTS221_T0_OUT_L_REG);
+    calib_data.T1_OUT = CAL16(HTS221_T1_OUT_L_REG);
 
     // Conversion des valeurs brutes en %
-    calib_data.H0_rh = (float)h0_rh_x2_val / 2.0f;
-    calib_data.H1_rh = (float)h1_rh_x2_val / 2.0f;
+    calib_data.H0_rh = (float)CAL(HTS221_H0_RH_X2_REG) / 2.0f;
+    calib_data.H1_rh = (float)CAL(HTS221_H1_RH_X2_REG) / 2.0f;
+
+    // Sorties brutes pour H0 et H1
+    calib_data.H0_T0_OUT = CAL16(HTS221_H0_T0_OUT_L_REG);
+    calib_data.H1_T0_OUT = CAL16(HTS221_H1_T0_OUT_L_REG);
 
-    // Lecture des sorties brutes pour H0 et H1
-    calib_data.H0_T0_OUT = (int16_t)(((uint16_t)HTS221_ReadReg(hi2c, HTS221_H0_T0_OUT_H_REG) << 8) | (uint16_t)HTS221_ReadReg(hi2c, HTS221_H0_T0_OUT_L_REG));
-    calib_data.H1_T0_OUT = (int16_t)(((uint16_t)HTS221_ReadReg(hi2c, HTS221_H1_T0_OUT_H_REG) << 8) | (uint16_t)HTS221_ReadReg(hi2c, HTS221_H1_T0_OUT_L_REG));
+#undef CAL16
+#undef CAL
+
+    // Précalcul de l'interpolation linéaire : une multiplication-addition par mesure
+    calib_data.T_valid = (calib_data.T1_OUT != calib_data.T0_OUT);
+    if (calib_data.T_valid) {
+        calib_data.T_slope = (calib_data.T1_degC - calib_data.T0_degC) / (float)(calib_data.T1_OUT - calib_data.T0_OUT);
+        calib_data.T_offset = calib_data.T0_degC - calib_data.T_slope * (float)calib_data.T0_OUT;
+    }
+    calib_data.H_valid = (calib_data.H1_T0_OUT != calib_data.H0_T0_OUT);
+    if (calib_data.H_valid) {
+        calib_data.H_slope = (calib_data.H1_rh - calib_data.H0_rh) / (float)(calib_data.H1_T0_OUT - calib_data.H0_T0_OUT);
+        calib_data.H_offset = calib_data.H0_rh - calib_data.H_slope * (float)calib_data.H0_T0_OUT;
+    }
 
     return HTS221_OK;
 }
 
+/**
+ * @brief Convertit une température brute à l'aide de la calibration précalculée.
+ * @param raw: Valeur brute TEMP_OUT.
+ * @retval Température en degrés Celsius.
+ */
+static float HTS221_CompensateTemperature(int16_t raw) {
+    return calib_data.T_slope * (float)raw + calib_data.T_offset;
+}
+
+/**
+ * @brief Convertit une humidité brute à l'aide de la calibration précalculée.
+ * @param raw: Valeur brute HUMIDITY_OUT.
+ * @retval Humidité relative en pourcentage, saturée entre 0 et 100 %.
+ */
+static float HTS221_CompensateHumidity(int16_t raw) {
+    float humidity = calib_data.H_slope * (float)raw + calib_data.H_offset;
+
+    // Saturation des valeurs entre 0 et 100 %
+    if (humidity < 0.0f) humidity = 0.0f;
+    if (humidity > 100.0f) humidity = 100.0f;
+
+    return humidity;
+}
+
 /**
  * @brief Initialise le capteur HTS221.
  * @param hi2c: Pointeur vers la structure I2C.
@@ -139,20 +225,20 @@ HTS221_Status HTS221_Init(I2C_HandleTypeDef *hi2c) {
  * @retval Température en degrés Celsius.
  */
 float HTS221_ReadTemperature(I2C_HandleTypeDef *hi2c) {
-    // Lecture des registres de température brute
-    uint8_t temp_l = HTS221_ReadReg(hi2c, HTS221_TEMP_OUT_L_REG);
-    uint8_t temp_h = HTS221_ReadReg(hi2c, HTS221_TEMP_OUT_H_REG);
-    int16_t temp_raw = (int16_t)(((uint16_t)temp_h << 8) | (uint16_t)temp_l);
-
     // Vérifie la validité des données de calibration
-    if (calib_data.T1_OUT == calib_data.T0_OUT) {
+    if (!calib_data.T_valid) {
         printf("Erreur HTS221: Calibration température invalide\r\n");
         return -273.15f; // Retourne une valeur d'erreur
     }
 
-    // Interpolation linéaire pour calculer la température
-    return calib_data.T0_degC + ((float)(temp_raw - calib_data.T0_OUT) * 
-           (calib_data.T1_degC - calib_data.T0_degC) / (float)(calib_data.T1_OUT - calib_data.T0_OUT));
+    // Lecture des registres de température brute (L puis H) en une transaction
+    uint8_t buf[2];
+    if (HTS221_ReadRegs(hi2c, HTS221_TEMP_OUT_L_REG, buf, 2) != HAL_OK) {
+        return -273.15f;
+    }
+    int16_t temp_raw = (int16_t)(((uint16_t)buf[1] << 8) | (uint16_t)buf[0]);
+
+    return HTS221_CompensateTemperature(temp_raw);
 }
 
 /**
@@ -161,24 +247,285 @@ float HTS221_ReadTemperature(I2C_HandleTypeDef *hi2c) {
  * @retval Humidité relative en pourcentage.
  */
 float HTS221_ReadHumidity(I2C_HandleTypeDef *hi2c) {
-    // Lecture des registres d'humidité brute
-    uint8_t hum_l = HTS221_ReadReg(hi2c, HTS221_HUMIDITY_OUT_L_REG);
-    uint8_t hum_h = HTS221_ReadReg(hi2c, HTS221_HUMIDITY_OUT_H_REG);
-    int16_t hum_raw = (int16_t)(((uint16_t)hum_h << 8) | (uint16_t)hum_l);
-
     // Vérifie la validité des données de calibration
-    if (calib_data.H1_T0_OUT == calib_data.H0_T0_OUT) {
+    if (!calib_data.H_valid) {
         printf("Erreur HTS221: Calibration humidité invalide\r\n");
         return -1.0f; // Retourne une valeur d'erreur
     }
 
-    // Interpolation linéaire pour calculer l'humidité
-    float humidity = calib_data.H0_rh + ((float)(hum_raw - calib_data.H0_T0_OUT) * 
-                    (calib_data.H1_rh - calib_data.H0_rh) / (float)(calib_data.H1_T0_OUT - calib_data.H0_T0_OUT));
+    // Lecture des registres d'humidité brute (L puis H) en une transaction
+    uint8_t buf[2];
+    if (HTS221_ReadRegs(hi2c, HTS221_HUMIDITY_OUT_L_REG, buf, 2) != HAL_OK) {
+        return -1.0f;
+    }
+    int16_t hum_raw = (int16_t)(((uint16_t)buf[1] << 8) | (uint16_t)buf[0]);
 
-    // Saturation des valeurs entre 0 et 100 %
-    if (humidity < 0.0f) humidity = 0.0f;
-    if (humidity > 100.0f) humidity = 100.0f;
+    return HTS221_CompensateHumidity(hum_raw);
+}
 
-    return humidity;
+/**
+ * @brief Lit température et humidité en une seule transaction I2C.
+ * @param hi2c: Pointeur vers la structure I2C.
+ * @param temperature: Pointeur de sortie pour la température en °C.
+ * @param humidity: Pointeur de sortie pour l'humidité relative en %.
+ * @retval HTS221_OK si les deux mesures sont nouvelles, HTS221_NOT_READY si le
+ *         capteur n'a pas encore produit de nouvel échantillon, HTS221_ERROR sinon.
+ * @note  STATUS_REG est lu seul d'abord : lire HUMIDITY_OUT_H ou TEMP_OUT_H remet à zéro le bit
+ *        H_DA/T_DA correspondant, une valeur fraîche serait donc perdue si une seule des deux était
+ *        prête. Les 4 octets HUMIDITY_OUT (0x28-0x29) et TEMP_OUT (0x2A-0x2B) sont ensuite lus d'un
+ *        seul bloc, uniquement quand T_DA et H_DA sont à 1.
+ */
+HTS221_Status HTS221_ReadAll(I2C_HandleTypeDef *hi2c, float *temperature, float *humidity) {
+    uint8_t status_reg;
+    uint8_t buf[4];
+
+    if (!calib_data.T_valid || !calib_data.H_valid) {
+        return HTS221_ERROR;
+    }
+    if (HTS221_ReadRegs(hi2c, HTS221_STATUS_REG, &status_reg, 1) != HAL_OK) {
+        return HTS221_ERROR;
+    }
+    if ((status_reg & (HTS221_STATUS_T_DA | HTS221_STATUS_H_DA)) != (HTS221_STATUS_T_DA | HTS221_STATUS_H_DA)) {
+        return HTS221_NOT_READY; // Sorties non lues : les bits DA restent positionnés
+    }
+    if (HTS221_ReadRegs(hi2c, HTS221_HUMIDITY_OUT_L_REG, buf, sizeof(buf)) != HAL_OK) {
+        return HTS221_ERROR;
+    }
+
+    *humidity = HTS221_CompensateHumidity((int16_t)(((uint16_t)buf[1] << 8) | (uint16_t)buf[0]));
+    *temperature = HTS221_CompensateTemperature((int16_t)(((uint16_t)buf[3] << 8) | (uint16_t)buf[2]));
+
+    return HTS221_OK;
+}
+
+/**
+ * @brief Configure la fréquence d'échantillonnage et le moyennage interne.
+ * @param hi2c: Pointeur vers la structure I2C.
+ * @param odr: Fréquence d'échantillonnage (HTS221_ODR_xxx).
+ * @param avgt: Nombre d'échantillons moyennés pour la température (HTS221_AVGT_xxx).
+ * @param avgh: Nombre d'échantillons moyennés pour l'humidité (HTS221_AVGH_xxx).
+ * @retval Statut de l'opération.
+ */
+HTS221_Status HTS221_Configure(I2C_HandleTypeDef *hi2c, HTS221_ODR odr, HTS221_AvgT avgt, HTS221_AvgH avgh) {
+    // AV_CONF : AVGT sur les bits 5..3, AVGH sur les bits 2..0
+    uint8_t av_conf = (uint8_t)((((uint8_t)avgt & 0x07) << 3) | ((uint8_t)avgh & 0x07));
+    if (HTS221_WriteReg(hi2c, HTS221_AV_CONF_REG, av_conf) != HAL_OK) {
+        return HTS221_ERROR;
+    }
+
+    // CTRL_REG1 : capteur actif, BDU pour que les lectures en bloc restent cohérentes
+    uint8_t ctrl1 = (uint8_t)(HTS221_CTRL1_PD | HTS221_CTRL1_BDU | ((uint8_t)odr & HTS221_CTRL1_ODR_MASK));
+    if (HTS221_WriteReg(hi2c, HTS221_CTRL_REG1, ctrl1) != HAL_OK) {
+        return HTS221_ERROR;
+    }
+    return HTS221_OK;
+}
+
+/**
+ * @brief Active ou désactive le signal "données prêtes" sur la broche DRDY.
+ * @param hi2c: Pointeur vers la structure I2C.
+ * @param enable: 1 pour activer, 0 pour désactiver.
+ * @retval Statut de l'opération.
+ */
+HTS221_Status HTS221_EnableDRDY(I2C_HandleTypeDef *hi2c, uint8_t enable) {
+    uint8_t ctrl3 = enable ? HTS221_CTRL3_DRDY_EN : 0x00;
+    return (HTS221_WriteReg(hi2c, HTS221_CTRL_REG3, ctrl3) == HAL_OK) ? HTS221_OK : HTS221_ERROR;
+}
+
+// --- Streaming sur interruption DRDY ---
+
+/**
+ * @brief Lit l'échantillon courant et l'ajoute au tampon circulaire.
+ * @param stream: Contexte de streaming.
+ * @retval Statut de HTS221_ReadAll : HTS221_OK signifie que les sorties ont été lues (DRDY retombe).
+ * @note  La lecture est toujours faite, même si le tampon est plein : c'est elle
+ *        qui fait retomber DRDY et permet au front montant suivant de se produire.
+ */
+static HTS221_Status HTS221_StreamFetch(HTS221_Stream *stream) {
+    float temperature, humidity;
+    HTS221_Status status = HTS221_ReadAll(stream->hi2c, &temperature, &humidity);
+    if (status == HTS221_NOT_READY) {
+        return status;
+    }
+    if (status != HTS221_OK) {
+        stream->dropped++; // Erreur I2C : l'échantillon est perdu
+        return status;
+    }
+
+    uint16_t head = stream->head;
+    uint16_t next = (uint16_t)((head + 1) & (HTS221_STREAM_BUFFER_SIZE - 1));
+    if (next == stream->tail) {
+        stream->dropped++; // Tampon plein : l'échantillon le plus récent est perdu
+        return HTS221_OK;
+    }
+
+    HTS221_Sample *sample = &stream->buffer[head];
+    sample->temperature = temperature;
+    sample->humidity = humidity;
+    sample->timestamp = HAL_GetTick();
+
+    stream->head = next; // Publication après écriture complète de l'échantillon
+    return HTS221_OK;
+}
+
+/**
+ * @brief Vide les sorties tant que DRDY est haut, puis (ré)active la lecture en interruption.
+ * @param stream: Contexte de streaming (active doit valoir 0 : l'interruption ne lit rien en parallèle).
+ * @retval HTS221_OK si DRDY est retombé et active vaut 1, sinon le statut de la dernière lecture
+ *         (HTS221_ERROR si DRDY reste haut malgré les lectures).
+ * @note  DRDY est un niveau : s'il est déjà haut, aucun front ne viendra réveiller l'EXTI.
+ *        Les sorties sont vidées ici tant que active = 0 (un seul producteur, pas d'appel HAL I2C
+ *        réentrant). Un front survenu juste avant active = 1 a été ignoré par l'interruption :
+ *        la broche est alors restée haute, on désactive et on vide à nouveau.
+ */
+static HTS221_Status HTS221_StreamDrain(HTS221_Stream *stream) {
+    HTS221_Status status = HTS221_ERROR;
+    for (uint8_t attempt = 0; attempt < HTS221_STREAM_DRAIN_MAX; attempt++) {
+        if (HAL_GPIO_ReadPin(stream->drdy_port, stream->drdy_pin) != GPIO_PIN_SET) {
+            stream->active = 1;
+            if (HAL_GPIO_ReadPin(stream->drdy_port, stream->drdy_pin) != GPIO_PIN_SET) {
+                return HTS221_OK;
+            }
+            stream->active = 0;
+        }
+        status = HTS221_StreamFetch(stream);
+        if (status != HTS221_OK) {
+            break; // Erreur I2C ou DRDY haut sans données : inutile d'insister
+        }
+    }
+    return (status == HTS221_OK) ? HTS221_ERROR : status;
+}
+
+/**
+ * @brief Active DRDY et démarre le remplissage du tampon depuis l'interruption EXTI.
+ * @param stream: Contexte de streaming.
+ * @param hi2c: Pointeur vers la structure I2C.
+ * @param drdy_port: Port GPIO relié à la broche DRDY.
+ * @param drdy_pin: Broche GPIO reliée à DRDY (configurée en EXTI front montant).
+ * @retval HTS221_ERROR si le capteur est en mode one-shot ou en cas d'erreur I2C.
+ */
+HTS221_Status HTS221_StreamStart(HTS221_Stream *stream, I2C_HandleTypeDef *hi2c,
+                                 GPIO_TypeDef *drdy_port, uint16_t drdy_pin) {
+    if (stream == NULL || hi2c == NULL) {
+        return HTS221_ERROR;
+    }
+
+    stream->active = 0;
+    stream->hi2c = hi2c;
+    stream->drdy_port = drdy_port;
+    stream->drdy_pin = drdy_pin;
+    stream->head = 0;
+    stream->tail = 0;
+    stream->dropped = 0;
+    stream->fault = 0;
+
+    // En mode one-shot, DRDY ne monterait qu'une seule fois
+    uint8_t ctrl1 = HTS221_ReadReg(hi2c, HTS221_CTRL_REG1);
+    if ((ctrl1 & HTS221_CTRL1_ODR_MASK) == HTS221_ODR_ONE_SHOT) {
+        printf("Erreur HTS221: Streaming impossible en mode one-shot (CTRL_REG1 = 0x%02X)\r\n", ctrl1);
+        return HTS221_ERROR;
+    }
+
+    if (HTS221_EnableDRDY(hi2c, 1) != HTS221_OK) {
+        return HTS221_ERROR;
+    }
+
+    if (HTS221_StreamDrain(stream) == HTS221_OK) {
+        return HTS221_OK;
+    }
+
+    printf("Erreur HTS221: DRDY reste actif, streaming non démarré\r\n");
+    HTS221_EnableDRDY(hi2c, 0);
+    return HTS221_ERROR;
+}
+
+/**
+ * @brief Arrête le streaming et désactive la broche DRDY.
+ * @param stream: Contexte de streaming.
+ * @retval Statut de l'opération. Les échantillons du tampon restent lisibles.
+ */
+HTS221_Status HTS221_StreamStop(HTS221_Stream *stream) {
+    if (stream == NULL || stream->hi2c == NULL) {
+        return HTS221_ERROR;
+    }
+    stream->active = 0;
+    return HTS221_EnableDRDY(stream->hi2c, 0);
+}
+
+/**
+ * @brief Relance le streaming si DRDY est resté haut (à appeler dans la boucle principale).
+ * @param stream: Contexte de streaming.
+ * @retval HTS221_OK si rien n'était bloqué ou si le streaming est reparti, sinon le statut de la
+ *         lecture (nouvelle tentative à l'appel suivant).
+ * @note  Après un échec de lecture dans l'interruption (erreur I2C, échantillon à moitié prêt),
+ *        DRDY reste haut et plus aucun front ne se produit. L'interruption est suspendue
+ *        (active = 0) le temps de vider les sorties : un seul producteur à la fois.
+ */
+HTS221_Status HTS221_StreamService(HTS221_Stream *stream) {
+    if (stream == NULL || !stream->active) {
+        return HTS221_OK;
+    }
+    if (HAL_GPIO_ReadPin(stream->drdy_port, stream->drdy_pin) != GPIO_PIN_SET) {
+        return HTS221_OK; // Fonctionnement normal : le prochain front réveillera l'EXTI
+    }
+
+    stream->active = 0;
+    HTS221_Status status = HTS221_StreamDrain(stream);
+    if (status != HTS221_OK) {
+        stream->active = 1; // Toujours en streaming : nouvelle tentative au prochain appel
+    }
+    return status;
+}
+
+/**
+ * @brief À appeler depuis HAL_GPIO_EXTI_Callback().
+ * @param stream: Contexte de streaming.
+ * @param GPIO_Pin: Broche ayant déclenché l'interruption.
+ */
+void HTS221_StreamIRQHandler(HTS221_Stream *stream, uint16_t GPIO_Pin) {
+    if (stream == NULL || !stream->active || GPIO_Pin != stream->drdy_pin) {
+        return;
+    }
+    if (HTS221_StreamFetch(stream) != HTS221_OK) {
+        stream->fault = 1; // DRDY reste haut : HTS221_StreamService() relancera le streaming
+    }
+}
+
+/**
+ * @brief Nombre d'échantillons disponibles dans le tampon.
+ */
+uint16_t HTS221_StreamAvailable(const HTS221_Stream *stream) {
+    if (stream == NULL) return 0;
+    return (uint16_t)((stream->head - stream->tail) & (HTS221_STREAM_BUFFER_SIZE - 1));
+}
+
+/**
+ * @brief Retire l'échantillon le plus ancien du tampon.
+ * @retval HTS221_OK, ou HTS221_NOT_READY si le tampon est vide.
+ */
+HTS221_Status HTS221_StreamRead(HTS221_Stream *stream, HTS221_Sample *sample) {
+    if (stream == NULL || sample == NULL) {
+        return HTS221_ERROR;
+    }
+    uint16_t tail = stream->tail;
+    if (tail == stream->head) {
+        return HTS221_NOT_READY; // Aucun échantillon disponible
+    }
+    *sample = stream->buffer[tail];
+    stream->tail = (uint16_t)((tail + 1) & (HTS221_STREAM_BUFFER_SIZE - 1));
+    return HTS221_OK;
+}
+
+/**
+ * @brief Nombre d'échantillons perdus (tampon plein ou erreur I2C) depuis le démarrage.
+ */
+uint32_t HTS221_StreamGetDropped(const HTS221_Stream *stream) {
+    return (stream == NULL) ? 0 : stream->dropped;
+}
+
+/**
+ * @brief Indique si une lecture en interruption a échoué depuis le démarrage (indicateur mémorisé).
+ */
+uint8_t HTS221_StreamGetFault(const HTS221_Stream *stream) {
+    return (stream == NULL) ? 0 : stream->fault;
 }
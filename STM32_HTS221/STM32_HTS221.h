@@ -5,9 +5,64 @@
 
 typedef enum {
     HTS221_OK,
-    HTS221_ERROR
+    HTS221_ERROR,
+    HTS221_NOT_READY     // Pas de nouvel échantillon disponible (STATUS_REG)
 } HTS221_Status;
 
+/* Fréquence d'échantillonnage (CTRL_REG1, bits ODR) */
+typedef enum {
+    HTS221_ODR_ONE_SHOT = 0,  // Mesure à la demande uniquement
+    HTS221_ODR_1HZ      = 1,
+    HTS221_ODR_7HZ      = 2,
+    HTS221_ODR_12_5HZ   = 3
+} HTS221_ODR;
+
+/* Moyennage interne de la température (AV_CONF, bits AVGT) */
+typedef enum {
+    HTS221_AVGT_2 = 0,
+    HTS221_AVGT_4,
+    HTS221_AVGT_8,
+    HTS221_AVGT_16,           // Valeur par défaut du capteur
+    HTS221_AVGT_32,
+    HTS221_AVGT_64,
+    HTS221_AVGT_128,
+    HTS221_AVGT_256
+} HTS221_AvgT;
+
+/* Moyennage interne de l'humidité (AV_CONF, bits AVGH) */
+typedef enum {
+    HTS221_AVGH_4 = 0,
+    HTS221_AVGH_8,
+    HTS221_AVGH_16,
+    HTS221_AVGH_32,           // Valeur par défaut du capteur
+    HTS221_AVGH_64,
+    HTS221_AVGH_128,
+    HTS221_AVGH_256,
+    HTS221_AVGH_512
+} HTS221_AvgH;
+
+/* Échantillon produit par le streaming DRDY */
+typedef struct {
+    float temperature;   // Température en °C
+    float humidity;      // Humidité relative en %
+    uint32_t timestamp;  // HAL_GetTick() au moment de la lecture
+} HTS221_Sample;
+
+#define HTS221_STREAM_BUFFER_SIZE 16 // Taille du tampon circulaire (puissance de 2, SIZE-1 échantillons utiles)
+
+/* Contexte de streaming (tampon circulaire sans verrou, producteur : EXTI / consommateur : boucle principale) */
+typedef struct {
+    I2C_HandleTypeDef *hi2c;                          // Bus du capteur
+    GPIO_TypeDef *drdy_port;                          // Port de la broche DRDY
+    uint16_t drdy_pin;                                // Broche DRDY (EXTI)
+    HTS221_Sample buffer[HTS221_STREAM_BUFFER_SIZE];  // Échantillons compensés
+    volatile uint16_t head;                           // Index d'écriture (HTS221_StreamIRQHandler)
+    volatile uint16_t tail;                           // Index de lecture (HTS221_StreamRead)
+    volatile uint32_t dropped;                        // Échantillons perdus
+    volatile uint8_t active;                          // 1 si le streaming est en cours
+    volatile uint8_t fault;                           // 1 si une lecture en interruption a échoué (mémorisé)
+} HTS221_Stream;
+
 /**
   * @brief  Initialise le capteur HTS221.
   * @param  hi2c: Pointeur vers la structure I2C.
@@ -29,4 +84,102 @@ float HTS221_ReadTemperature(I2C_HandleTypeDef *hi2c);
   */
 float HTS221_ReadHumidity(I2C_HandleTypeDef *hi2c);
 
+/**
+  * @brief  Lit température et humidité (une lecture groupée des sorties), si toutes deux sont nouvelles.
+  * @param  hi2c: Pointeur vers la structure I2C.
+  * @param  temperature: Température en degrés Celsius (sortie).
+  * @param  humidity: Humidité relative en pourcentage (sortie).
+  * @retval HTS221_OK, HTS221_NOT_READY si aucun nouvel échantillon, HTS221_ERROR.
+  */
+HTS221_Status HTS221_ReadAll(I2C_HandleTypeDef *hi2c, float *temperature, float *humidity);
+
+/**
+  * @brief  Configure la fréquence d'échantillonnage (CTRL_REG1) et le moyennage (AV_CONF).
+  * @param  hi2c: Pointeur vers la structure I2C.
+  * @param  odr: Fréquence d'échantillonnage.
+  * @param  avgt: Moyennage de la température.
+  * @param  avgh: Moyennage de l'humidité.
+  * @retval HTS221_Status: Statut de l'opération.
+  * @note   Active aussi BDU : les octets L et H lus appartiennent toujours au même échantillon.
+  *         Plus le moyennage est élevé, plus le bruit est faible et la consommation élevée.
+  */
+HTS221_Status HTS221_Configure(I2C_HandleTypeDef *hi2c, HTS221_ODR odr, HTS221_AvgT avgt, HTS221_AvgH avgh);
+
+/**
+  * @brief  Active ou désactive le signal "données prêtes" sur la broche DRDY (CTRL_REG3).
+  * @param  hi2c: Pointeur vers la structure I2C.
+  * @param  enable: 1 pour activer (push-pull, actif haut), 0 pour désactiver.
+  * @retval HTS221_Status: Statut de l'opération.
+  */
+HTS221_Status HTS221_EnableDRDY(I2C_HandleTypeDef *hi2c, uint8_t enable);
+
+/**
+  * @brief  Démarre le streaming : active DRDY et vide le tampon circulaire.
+  * @param  stream: Contexte de streaming.
+  * @param  hi2c: Pointeur vers la structure I2C.
+  * @param  drdy_port: Port GPIO relié à DRDY.
+  * @param  drdy_pin: Broche GPIO reliée à DRDY, configurée en EXTI sur front montant.
+  * @retval HTS221_Status: HTS221_ERROR si le capteur est en mode one-shot, en cas d'erreur I2C ou si
+  *         DRDY ne retombe pas (DRDY est alors désactivé).
+  * @note   Appeler HTS221_Configure() avec une fréquence non nulle au préalable.
+  *         Un échantillon déjà prêt est vidé dans le tampon avant l'activation de l'interruption :
+  *         appeler depuis le code principal, pas depuis une interruption de priorité supérieure à l'EXTI.
+  *         La lecture I2C est faite dans l'interruption : la priorité de l'EXTI doit être
+  *         inférieure à celle du SysTick, et le bus ne doit pas être utilisé ailleurs pendant le streaming.
+  */
+HTS221_Status HTS221_StreamStart(HTS221_Stream *stream, I2C_HandleTypeDef *hi2c,
+                                 GPIO_TypeDef *drdy_port, uint16_t drdy_pin);
+
+/**
+  * @brief  Arrête le streaming et désactive DRDY. Les échantillons déjà reçus restent lisibles.
+  * @param  stream: Contexte de streaming.
+  * @retval HTS221_Status: Statut de l'opération.
+  */
+HTS221_Status HTS221_StreamStop(HTS221_Stream *stream);
+
+/**
+  * @brief  À appeler depuis HAL_GPIO_EXTI_Callback() : lit l'échantillon et l'ajoute au tampon.
+  * @param  stream: Contexte de streaming.
+  * @param  GPIO_Pin: Broche ayant déclenché l'interruption (ignorée si ce n'est pas DRDY).
+  */
+void HTS221_StreamIRQHandler(HTS221_Stream *stream, uint16_t GPIO_Pin);
+
+/**
+  * @brief  À appeler régulièrement dans la boucle principale : relance le streaming si DRDY est resté
+  *         haut après un échec de lecture dans l'interruption (aucun front ne se produirait plus).
+  * @param  stream: Contexte de streaming.
+  * @retval HTS221_Status: HTS221_OK si le streaming tourne, sinon statut de la lecture (réessayée au prochain appel).
+  * @note   Même contrainte que HTS221_StreamStart() : depuis le code principal uniquement.
+  */
+HTS221_Status HTS221_StreamService(HTS221_Stream *stream);
+
+/**
+  * @brief  Nombre d'échantillons disponibles dans le tampon.
+  * @param  stream: Contexte de streaming.
+  * @retval Nombre d'échantillons.
+  */
+uint16_t HTS221_StreamAvailable(const HTS221_Stream *stream);
+
+/**
+  * @brief  Retire l'échantillon le plus ancien du tampon.
+  * @param  stream: Contexte de streaming.
+  * @param  sample: Échantillon lu (sortie).
+  * @retval HTS221_OK, ou HTS221_NOT_READY si le tampon est vide.
+  */
+HTS221_Status HTS221_StreamRead(HTS221_Stream *stream, HTS221_Sample *sample);
+
+/**
+  * @brief  Nombre d'échantillons perdus (tampon plein ou erreur I2C) depuis le démarrage.
+  * @param  stream: Contexte de streaming.
+  * @retval Nombre d'échantillons perdus.
+  */
+uint32_t HTS221_StreamGetDropped(const HTS221_Stream *stream);
+
+/**
+  * @brief  Indique si une lecture en interruption a échoué depuis HTS221_StreamStart().
+  * @param  stream: Contexte de streaming.
+  * @retval 1 si un échec a été mémorisé (DRDY a pu rester haut jusqu'au prochain HTS221_StreamService()), 0 sinon.
+  */
+uint8_t HTS221_StreamGetFault(const HTS221_Stream *stream);
+
 #endif /* STM32_HTS221_H_ */